@@ -10,6 +10,11 @@ emcc -O3 \
     src/geradorArquivos/GeradorWeb.cpp \
     src/geradorArquivos/GeradorHorario.cpp \
     src/geradorArquivos/SimulatedAnnealing.cpp \
+    src/geradorArquivos/InstanciaCompilada.cpp \
+    src/geradorArquivos/CacheCusto.cpp \
+    src/geradorArquivos/KernelsPenalidade.cpp \
+    src/geradorArquivos/ConstrucaoParalela.cpp \
+    src/geradorArquivos/TemperaturaParalela.cpp \
     -s WASM=1 \
     -s EXPORTED_FUNCTIONS='["_malloc", "_free"]' \
     -s EXPORTED_RUNTIME_METHODS='["ccall", "cwrap", "UTF8ToString"]' \
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// ==============================================================================
+// GERADOR DE NÚMEROS ALEATÓRIOS
+// ==============================================================================
+
+// Mistura de 64 bits do splitmix64: expande sementes e deriva fluxos
+inline uint64_t misturarSplitMix64(uint64_t& estado) {
+    uint64_t z = (estado += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Semente não determinística, para configurações com semente 0
+inline uint64_t sementeNaoDeterministica() {
+    std::random_device rd;
+    uint64_t semente = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    return semente != 0 ? semente : 1;
+}
+
+// xoshiro256** (Blackman e Vigna): 256 bits de estado, período 2^256 - 1.
+// Satisfaz UniformRandomBitGenerator, então serve para std::shuffle.
+// Execuções paralelas usam fluxo(sementeMestre, indice): cada índice (thread,
+// réplica, tentativa) recebe um estado derivado só da semente mestre e do
+// índice, o que torna o resultado reproduzível independentemente do
+// escalonamento das threads.
+class Aleatorio {
+public:
+    using result_type = uint64_t;
+
+    explicit Aleatorio(uint64_t semente = 0) { semear(semente); }
+
+    // Fluxo independente de número `indice` derivado de uma semente mestre
+    static Aleatorio fluxo(uint64_t sementeMestre, uint64_t indice) {
+        uint64_t estado = sementeMestre;
+        uint64_t base = misturarSplitMix64(estado);
+        estado = base ^ (indice * 0xd1b54a32d192ed03ULL);
+        return Aleatorio(misturarSplitMix64(estado));
+    }
+
+    void semear(uint64_t semente) {
+        uint64_t estado = semente;
+        for (auto& palavra : s) {
+            palavra = misturarSplitMix64(estado);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t resultado = rotacionar(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotacionar(s[3], 45);
+
+        return resultado;
+    }
+
+    // Inteiro uniforme em [0, limite), sem viés (multiplicação de Lemire
+    // com rejeição); limite deve ser maior que zero
+    uint32_t inteiro(uint32_t limite) {
+        uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * limite;
+        uint32_t baixo = static_cast<uint32_t>(m);
+        if (baixo < limite) {
+            const uint32_t limiar = static_cast<uint32_t>(-limite) % limite;
+            while (baixo < limiar) {
+                m = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * limite;
+                baixo = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // Inteiro uniforme em [minimo, maximo]
+    int intervalo(int minimo, int maximo) {
+        return minimo + static_cast<int>(inteiro(static_cast<uint32_t>(maximo - minimo) + 1));
+    }
+
+    // Real uniforme em [0, 1) com 53 bits de precisão
+    double real() {
+        return ((*this)() >> 11) * 0x1.0p-53;
+    }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotacionar(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
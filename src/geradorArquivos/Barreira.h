@@ -0,0 +1,36 @@
+#pragma once
+#include <mutex>
+#include <condition_variable>
+
+// ==============================================================================
+// BARREIRA
+// ==============================================================================
+
+// Barreira reutilizável entre um grupo fixo de threads: cada aguardar()
+// retorna só quando todos os participantes chegaram a ele. O que uma thread
+// escreveu antes da barreira é visto pelas outras depois dela.
+// (std::barrier só existe a partir do C++20)
+class Barreira {
+public:
+    explicit Barreira(int participantes)
+        : participantes(participantes), restantes(participantes), geracao(0) {}
+
+    void aguardar() {
+        std::unique_lock<std::mutex> trava(mutex);
+        int minhaGeracao = geracao;
+        if (--restantes == 0) {
+            geracao++;
+            restantes = participantes;
+            condicao.notify_all();
+        } else {
+            condicao.wait(trava, [&] { return geracao != minhaGeracao; });
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condicao;
+    int participantes;
+    int restantes;
+    int geracao;
+};
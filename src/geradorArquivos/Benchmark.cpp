@@ -0,0 +1,391 @@
+#include "GeradorHorario.h"
+#include "SimulatedAnnealing.h"
+#include "ConstrucaoParalela.h"
+#include "DadosEntrada.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+// ==============================================================================
+// BENCHMARKS DO GERADOR (EXECUTÁVEL NATIVO)
+// ==============================================================================
+//
+// Micro-benchmarks dos núcleos da Fase 1 (verificarDisponibilidade,
+// calcularPontuacaoSlot), do custo (cada penalidade e o custo completo), da
+// viabilidade e de cada tipo de movimento do SA, e macro-benchmarks de uma
+// Fase 1 completa e de uma execução do SA com semente fixa. Os resultados vão
+// para um arquivo JSON; com --baseline, o mínimo de cada resultado (menos
+// sujeito a ruído que a mediana) é comparado com o de mesmo nome de uma
+// execução anterior e o programa termina com código 1 se algum ficou mais
+// lento que a tolerância.
+//
+// Uso: ./benchmark [arquivo_dados.json] [--saida resultado.json]
+//                  [--baseline base.json] [--tolerancia 0.10]
+//                  [--semente N] [--amostras N]
+
+struct ResultadoBenchmark {
+    std::string nome;
+    std::string unidade;          // "ns/op" (micro) ou "ms" (macro)
+    double valor = 0.0;           // Mediana das amostras
+    double minimo = 0.0;
+    long long operacoesPorAmostra = 1;
+    json detalhes = json::object();
+};
+
+namespace {
+
+int numAmostras = 5;
+const double NS_POR_AMOSTRA_MICRO = 20e6; // Duração alvo de cada amostra (20 ms)
+
+// Acumula os resultados das operações medidas para que não sejam eliminadas
+volatile double sumidouro = 0.0;
+
+double mediana(std::vector<double> valores) {
+    std::sort(valores.begin(), valores.end());
+    size_t meio = valores.size() / 2;
+    return valores.size() % 2 ? valores[meio] : (valores[meio - 1] + valores[meio]) / 2.0;
+}
+
+// Mede operacao(i) para i = 0, 1, 2... O lote é dobrado até uma amostra
+// durar NS_POR_AMOSTRA_MICRO; o resultado é a mediana de numAmostras lotes
+template <typename Operacao>
+ResultadoBenchmark medirMicro(const std::string& nome, Operacao&& operacao) {
+    auto medirLote = [&](long long lote) {
+        double acumulado = 0.0;
+        auto inicio = std::chrono::steady_clock::now();
+        for (long long i = 0; i < lote; i++) {
+            acumulado += operacao(i);
+        }
+        auto fim = std::chrono::steady_clock::now();
+        sumidouro = sumidouro + acumulado;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(fim - inicio).count());
+    };
+
+    long long lote = 1;
+    while (lote < (1LL << 30) && medirLote(lote) < NS_POR_AMOSTRA_MICRO) {
+        lote *= 2;
+    }
+
+    std::vector<double> amostras;
+    for (int a = 0; a < numAmostras; a++) {
+        amostras.push_back(medirLote(lote) / lote);
+    }
+
+    ResultadoBenchmark resultado;
+    resultado.nome = nome;
+    resultado.unidade = "ns/op";
+    resultado.valor = mediana(amostras);
+    resultado.minimo = *std::min_element(amostras.begin(), amostras.end());
+    resultado.operacoesPorAmostra = lote;
+    return resultado;
+}
+
+// Mede execucao() numAmostras vezes, em milissegundos. execucao devolve os
+// detalhes da última amostra (que devem ser iguais em todas, com semente fixa)
+template <typename Execucao>
+ResultadoBenchmark medirMacro(const std::string& nome, Execucao&& execucao) {
+    ResultadoBenchmark resultado;
+    resultado.nome = nome;
+    resultado.unidade = "ms";
+
+    std::vector<double> amostras;
+    for (int a = 0; a < numAmostras; a++) {
+        auto inicio = std::chrono::steady_clock::now();
+        resultado.detalhes = execucao();
+        auto fim = std::chrono::steady_clock::now();
+        amostras.push_back(std::chrono::duration<double, std::milli>(fim - inicio).count());
+    }
+
+    resultado.valor = mediana(amostras);
+    resultado.minimo = *std::min_element(amostras.begin(), amostras.end());
+    return resultado;
+}
+
+} // namespace
+
+// Acesso aos métodos internos medidos (friend de GeradorHorario e SimulatedAnnealing)
+class AcessoBenchmark {
+public:
+    // Núcleos da Fase 1 sobre a grade parcial em que o gerador está
+    static void medirFase1(GeradorHorario& gerador, std::vector<ResultadoBenchmark>& resultados) {
+        std::vector<RequisicaoCompilada> requisicoes;
+        for (const auto& req : gerador.requisicoesCompiladas) {
+            if (req.sala >= 0) {
+                requisicoes.push_back(req);
+            }
+        }
+        if (requisicoes.empty()) return;
+
+        const long long total = static_cast<long long>(requisicoes.size()) * NUM_SLOTS;
+        resultados.push_back(medirMicro("fase1.verificarDisponibilidade", [&](long long i) {
+            long long k = i % total;
+            return gerador.verificarDisponibilidade(requisicoes[k / NUM_SLOTS],
+                                                    Slot::fromId(static_cast<int>(k % NUM_SLOTS))) ? 1.0 : 0.0;
+        }));
+        resultados.push_back(medirMicro("fase1.calcularPontuacaoSlot", [&](long long i) {
+            long long k = i % total;
+            return static_cast<double>(gerador.calcularPontuacaoSlot(
+                requisicoes[k / NUM_SLOTS], Slot::fromId(static_cast<int>(k % NUM_SLOTS))));
+        }));
+    }
+
+    // Custo, viabilidade e movimentos sobre a solução atual do SA
+    static void medirSA(SimulatedAnnealing& sa, std::vector<ResultadoBenchmark>& resultados) {
+        const auto& solucao = sa.solucaoAtual;
+
+        resultados.push_back(medirMicro("custo.penalidade1.distribuicao",
+                                        [&](long long) { return sa.calcularPenalidade1(solucao); }));
+        resultados.push_back(medirMicro("custo.penalidade2.consecutivas",
+                                        [&](long long) { return sa.calcularPenalidade2(solucao); }));
+        resultados.push_back(medirMicro("custo.penalidade3.janelas",
+                                        [&](long long) { return sa.calcularPenalidade3(solucao); }));
+        resultados.push_back(medirMicro("custo.penalidade4.extremos",
+                                        [&](long long) { return sa.calcularPenalidade4(solucao); }));
+        resultados.push_back(medirMicro("custo.penalidade5.preferencias",
+                                        [&](long long) { return sa.calcularPenalidade5(solucao); }));
+        // Custo completo sem o cache (o que calcularCusto faz a cada falta)
+        resultados.push_back(medirMicro("custo.completo", [&](long long) {
+            return sa.combinarPenalidades(sa.calcularPenalidade1(solucao), sa.calcularPenalidade2(solucao),
+                                          sa.calcularPenalidade3(solucao), sa.calcularPenalidade4(solucao),
+                                          sa.calcularPenalidade5(solucao));
+        }));
+        resultados.push_back(medirMicro("viabilidade.completa",
+                                        [&](long long) { return sa.verificarViabilidade(solucao) ? 1.0 : 0.0; }));
+
+        // Ciclo de avaliação de um movimento como em executarIteracao: sorteio,
+        // vizinho, viabilidade rápida e, se viável, aplicação, custo
+        // incremental e desfazer (a solução atual não muda). Sem blocos
+        // geminados, moverGeminada não tem o que sortear
+        for (int t = 0; t < NUM_TIPOS_MOVIMENTO; t++) {
+            TipoMovimento tipo = static_cast<TipoMovimento>(t);
+            if (tipo == TipoMovimento::MOVER_GEMINADA && sa.paresGeminados.empty()) continue;
+            long long propostos = 0;
+            long long viaveis = 0;
+
+            ResultadoBenchmark resultado = medirMicro(std::string("sa.movimento.") + nomeTipoMovimento(tipo), [&](long long) {
+                Movimento movimento(tipo);
+                sa.sortearParametros(movimento);
+                sa.gerarVizinho(movimento);
+                propostos++;
+                if (movimento.alteracoes.empty() || !sa.verificarViabilidadeRapida(movimento)) {
+                    return 0.0;
+                }
+                viaveis++;
+                sa.aplicarMovimento(movimento);
+                double custo = sa.calcularCustoIncremental(movimento);
+                sa.desfazerMovimento();
+                return custo;
+            });
+            resultado.detalhes["taxaViabilidade"] = propostos > 0 ? static_cast<double>(viaveis) / propostos : 0.0;
+            resultados.push_back(resultado);
+        }
+    }
+};
+
+namespace {
+
+json paraJSON(const ResultadoBenchmark& r) {
+    json j;
+    j["nome"] = r.nome;
+    j["unidade"] = r.unidade;
+    j["valor"] = r.valor;
+    j["minimo"] = r.minimo;
+    j["operacoesPorAmostra"] = r.operacoesPorAmostra;
+    j["detalhes"] = r.detalhes;
+    return j;
+}
+
+// Compara com a linha de base; devolve o número de regressões
+int compararComBaseline(const std::vector<ResultadoBenchmark>& resultados,
+                        const std::string& arquivo, double tolerancia) {
+    std::ifstream entrada(arquivo);
+    if (!entrada.is_open()) {
+        std::cerr << "Erro ao abrir linha de base: " << arquivo << std::endl;
+        return 0;
+    }
+
+    json base;
+    entrada >> base;
+
+    std::map<std::string, json> resultadosBase;
+    for (const auto& r : base["resultados"]) {
+        resultadosBase[r["nome"].get<std::string>()] = r;
+    }
+
+    std::cout << "\n=== COMPARAÇÃO COM A LINHA DE BASE (" << arquivo << ") ===" << std::endl;
+    std::cout << std::left << std::setw(36) << "Benchmark" << std::right
+              << std::setw(14) << "Base" << std::setw(14) << "Atual" << std::setw(10) << "Razão" << std::endl;
+
+    int regressoes = 0;
+    for (const auto& r : resultados) {
+        auto it = resultadosBase.find(r.nome);
+        std::cout << std::left << std::setw(36) << r.nome << std::right << std::fixed << std::setprecision(2);
+        double minimoBase = it != resultadosBase.end() ? it->second.value("minimo", 0.0) : 0.0;
+        if (minimoBase <= 0.0) {
+            std::cout << std::setw(14) << "-" << std::setw(14) << r.minimo << std::setw(10) << "novo" << std::endl;
+            continue;
+        }
+
+        double razao = r.minimo / minimoBase;
+        std::cout << std::setw(14) << minimoBase << std::setw(14) << r.minimo
+                  << std::setw(9) << razao << "x";
+        if (razao > 1.0 + tolerancia) {
+            std::cout << "  REGRESSÃO";
+            regressoes++;
+        } else if (razao < 1.0 - tolerancia) {
+            std::cout << "  melhoria";
+        }
+        // Com a mesma semente, tentativas e custo final só mudam com o algoritmo
+        if (r.unidade == "ms" && it->second.contains("detalhes") && it->second["detalhes"] != r.detalhes) {
+            std::cout << "  (resultado mudou: " << it->second["detalhes"].dump()
+                      << " -> " << r.detalhes.dump() << ")";
+        }
+        std::cout << std::endl;
+    }
+
+    return regressoes;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string arquivoDados;
+    std::string arquivoSaida = "benchmark.json";
+    std::string arquivoBaseline;
+    double tolerancia = 0.10;
+    uint64_t semente = 42;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argumento = argv[i];
+        if (argumento == "--saida" && i + 1 < argc) {
+            arquivoSaida = argv[++i];
+        } else if (argumento == "--baseline" && i + 1 < argc) {
+            arquivoBaseline = argv[++i];
+        } else if (argumento == "--tolerancia" && i + 1 < argc) {
+            tolerancia = std::stod(argv[++i]);
+        } else if (argumento == "--semente" && i + 1 < argc) {
+            semente = std::stoull(argv[++i]);
+        } else if (argumento == "--amostras" && i + 1 < argc) {
+            numAmostras = std::max(std::stoi(argv[++i]), 1);
+        } else {
+            arquivoDados = argumento;
+        }
+    }
+    if (semente == 0) {
+        semente = 42; // Benchmarks sempre com semente fixa
+    }
+
+    std::vector<Professor> professores;
+    std::vector<Disciplina> disciplinas;
+    std::vector<Turma> turmas;
+    std::vector<Sala> salas;
+    std::vector<RequisicaoAlocacao> requisicoes;
+    std::set<std::tuple<int, int, int>> disponibilidade;
+    std::map<int, int> turmaSalaMap;
+    std::map<int, int> disponibilidadeTotalProf;
+
+    if (!arquivoDados.empty()) {
+        carregarDadosJSON(arquivoDados, professores, disciplinas, turmas,
+                          salas, requisicoes, disponibilidade, turmaSalaMap,
+                          disponibilidadeTotalProf);
+    } else {
+        setupDadosExemplo(professores, disciplinas, turmas, salas,
+                          requisicoes, disponibilidade, turmaSalaMap);
+        for (const auto& disp : disponibilidade) {
+            disponibilidadeTotalProf[std::get<0>(disp)]++;
+        }
+    }
+
+    ConfiguracaoGerador configGerador;
+    configGerador.semente = semente;
+    GeradorHorario gerador(professores, disciplinas, turmas, salas, requisicoes,
+                           disponibilidade, disponibilidadeTotalProf, turmaSalaMap, configGerador);
+
+    ConfiguracaoConstrucao configConstrucao;
+    configConstrucao.numThreads = 1;
+
+    std::vector<ResultadoBenchmark> resultados;
+
+    // Macro: Fase 1 completa (uma thread, mesma sequência de tentativas)
+    std::cout << "\n=== BENCHMARKS (" << numAmostras << " amostras) ===" << std::endl;
+    std::vector<Aula> grade;
+    resultados.push_back(medirMacro("macro.fase1", [&]() {
+        ConstrucaoParalela construcao(gerador.getInstancia(), requisicoes, configGerador, configConstrucao);
+        ResultadoConstrucao resultado = construcao.executar();
+        if (resultado.sucesso) {
+            grade = resultado.grades.front();
+        }
+        return json{{"sucesso", resultado.sucesso}, {"tentativas", resultado.tentativas}};
+    }));
+
+    if (grade.empty()) {
+        std::cerr << "Fase 1 sem solução completa: benchmarks do SA não executados" << std::endl;
+        return 1;
+    }
+
+    // Micro: núcleos da Fase 1 com metade da grade alocada
+    gerador.setGradeHoraria(std::vector<Aula>(grade.begin(), grade.begin() + grade.size() / 2));
+    AcessoBenchmark::medirFase1(gerador, resultados);
+
+    // Micro: custo, viabilidade e movimentos sobre a solução da Fase 1
+    ConfiguracaoSA configSA;
+    configSA.semente = semente;
+    SimulatedAnnealing sa(grade, gerador.getInstancia(), configSA);
+    AcessoBenchmark::medirSA(sa, resultados);
+
+    // Macro: SA completo com semente fixa
+    resultados.push_back(medirMacro("macro.sa", [&]() {
+        SimulatedAnnealing execucao(grade, gerador.getInstancia(), configSA);
+        execucao.executar();
+        return json{{"iteracoes", configSA.numIteracoes}, {"custoFinal", execucao.getCustoFinal()}};
+    }));
+
+    // Resumo no console
+    std::cout << std::left << std::setw(36) << "Benchmark" << std::right
+              << std::setw(14) << "Mediana" << std::setw(14) << "Mínimo" << "  Unidade" << std::endl;
+    for (const auto& r : resultados) {
+        std::cout << std::left << std::setw(36) << r.nome << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << r.valor << std::setw(14) << r.minimo << "  " << r.unidade << std::endl;
+    }
+
+    // Saída JSON
+    std::time_t agora = std::time(nullptr);
+    char data[32];
+    std::strftime(data, sizeof(data), "%Y-%m-%dT%H:%M:%S", std::localtime(&agora));
+
+    json saida;
+    saida["data"] = data;
+    saida["configuracao"] = {
+        {"dados", arquivoDados.empty() ? "exemplo" : arquivoDados},
+        {"aulas", grade.size()},
+        {"semente", semente},
+        {"amostras", numAmostras}
+    };
+    saida["resultados"] = json::array();
+    for (const auto& r : resultados) {
+        saida["resultados"].push_back(paraJSON(r));
+    }
+
+    std::ofstream arquivo(arquivoSaida);
+    arquivo << saida.dump(2) << std::endl;
+    std::cout << "\nResultados exportados para: " << arquivoSaida << std::endl;
+
+    if (!arquivoBaseline.empty()) {
+        int regressoes = compararComBaseline(resultados, arquivoBaseline, tolerancia);
+        if (regressoes > 0) {
+            std::cout << "\n" << regressoes << " regressão(ões) acima de "
+                      << tolerancia * 100 << "%" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
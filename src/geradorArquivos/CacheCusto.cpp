@@ -0,0 +1,80 @@
+#include "CacheCusto.h"
+#include <algorithm>
+
+CacheCusto::CacheCusto(size_t capacidade)
+    : ponteiroRelogio(0), consultas(0), acertos(0)
+{
+    size_t tamanho = JANELA_SONDAGEM;
+    while (tamanho < capacidade) {
+        tamanho <<= 1;
+    }
+    entradas.resize(tamanho);
+    mascara = tamanho - 1;
+}
+
+// Espalha os bits da chave antes de reduzir à tabela (finalizador do splitmix64)
+size_t CacheCusto::posicaoInicial(uint64_t chave) const {
+    chave ^= chave >> 30;
+    chave *= 0xbf58476d1ce4e5b9ULL;
+    chave ^= chave >> 27;
+    chave *= 0x94d049bb133111ebULL;
+    chave ^= chave >> 31;
+    return static_cast<size_t>(chave) & mascara;
+}
+
+bool CacheCusto::buscar(uint64_t chave, double& custo) {
+    consultas++;
+
+    size_t inicio = posicaoInicial(chave);
+    for (size_t i = 0; i < JANELA_SONDAGEM; i++) {
+        Entrada& entrada = entradas[(inicio + i) & mascara];
+        if (!entrada.ocupada) {
+            return false; // Entradas nunca são removidas: a chave não está adiante
+        }
+        if (entrada.chave == chave) {
+            entrada.referenciada = true;
+            custo = entrada.custo;
+            acertos++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CacheCusto::inserir(uint64_t chave, double custo) {
+    size_t inicio = posicaoInicial(chave);
+
+    // Atualizar a chave se já existe, ou ocupar a primeira posição livre
+    for (size_t i = 0; i < JANELA_SONDAGEM; i++) {
+        Entrada& entrada = entradas[(inicio + i) & mascara];
+        if (!entrada.ocupada || entrada.chave == chave) {
+            entrada.chave = chave;
+            entrada.custo = custo;
+            entrada.ocupada = true;
+            entrada.referenciada = false;
+            return;
+        }
+    }
+
+    // Janela cheia: relógio sobre as posições da janela
+    for (size_t passo = 0; passo < 2 * JANELA_SONDAGEM; passo++) {
+        Entrada& entrada = entradas[(inicio + ponteiroRelogio % JANELA_SONDAGEM) & mascara];
+        ponteiroRelogio++;
+
+        if (entrada.referenciada) {
+            entrada.referenciada = false; // Segunda chance
+            continue;
+        }
+
+        entrada.chave = chave;
+        entrada.custo = custo;
+        entrada.referenciada = false;
+        return;
+    }
+}
+
+void CacheCusto::limpar() {
+    std::fill(entradas.begin(), entradas.end(), Entrada());
+    ponteiroRelogio = 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// ==============================================================================
+// CACHE DE CUSTO
+// ==============================================================================
+
+// Cache de custos de soluções com capacidade fixa, indexado pelo hash Zobrist
+// de 64 bits da solução. Usa endereçamento aberto com sondagem linear limitada
+// a uma janela curta; a chave completa é comparada em toda consulta, então um
+// slot ocupado por outra solução nunca devolve um custo errado. Quando a janela
+// está cheia, a entrada substituída é escolhida pela política do relógio
+// (segunda chance): entradas consultadas desde a última passagem sobrevivem.
+class CacheCusto {
+public:
+    // A capacidade é arredondada para a próxima potência de dois
+    explicit CacheCusto(size_t capacidade = 4096);
+
+    bool buscar(uint64_t chave, double& custo);
+    void inserir(uint64_t chave, double custo);
+    void limpar();
+
+    size_t getCapacidade() const { return entradas.size(); }
+    size_t getConsultas() const { return consultas; }
+    size_t getAcertos() const { return acertos; }
+
+private:
+    struct Entrada {
+        uint64_t chave = 0;
+        double custo = 0.0;
+        bool ocupada = false;
+        bool referenciada = false;
+    };
+
+    static constexpr size_t JANELA_SONDAGEM = 8;
+
+    std::vector<Entrada> entradas;
+    size_t mascara;
+    size_t ponteiroRelogio;
+    size_t consultas;
+    size_t acertos;
+
+    size_t posicaoInicial(uint64_t chave) const;
+};
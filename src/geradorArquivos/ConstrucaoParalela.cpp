@@ -0,0 +1,152 @@
+#include "ConstrucaoParalela.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <map>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+
+ConstrucaoParalela::ConstrucaoParalela(
+    std::shared_ptr<const InstanciaCompilada> instancia,
+    std::vector<RequisicaoAlocacao> requisicoes,
+    ConfiguracaoGerador configGerador,
+    ConfiguracaoConstrucao config)
+    : instancia(std::move(instancia)), requisicoes(std::move(requisicoes)),
+      configGerador(configGerador), config(config)
+{
+    // Workers concorrentes não podem compartilhar a saída detalhada
+    this->configGerador.verboso = false;
+}
+
+int ConstrucaoParalela::getNumThreads() const {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return 1; // WebAssembly sem suporte a threads
+#else
+    int n = config.numThreads;
+    if (n <= 0) {
+        n = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    n = std::max(n, 1);
+    return std::min(n, std::max(config.maxTentativas, 1));
+#endif
+}
+
+// Custo da grade segundo a função objetivo do SA (sem otimizar)
+double ConstrucaoParalela::avaliarGrade(const std::vector<Aula>& grade) const {
+    ConfiguracaoSA configAvaliacao = config.avaliacao;
+    configAvaliacao.verboso = false;
+    configAvaliacao.capacidadeCacheCusto = 1;
+    SimulatedAnnealing avaliador(grade, instancia, configAvaliacao);
+    return avaliador.getCustoFinal();
+}
+
+ResultadoConstrucao ConstrucaoParalela::executar() {
+    ResultadoConstrucao resultado;
+    resultado.threads = getNumThreads();
+
+    const int maxTentativas = std::max(config.maxTentativas, 0);
+    const size_t melhoresK = static_cast<size_t>(std::max(config.melhoresK, 1));
+
+    const uint64_t semente = configGerador.semente != 0 ? configGerador.semente
+                                                        : sementeNaoDeterministica();
+
+    std::atomic<int> proximaTentativa(0);
+    std::atomic<int> ultimaNecessaria(maxTentativas); // Tentativas posteriores são canceladas
+    std::atomic<bool> prazoEsgotado(false);
+    std::mutex mutexResultado;
+    std::map<int, std::vector<Aula>> gradesPorTentativa;
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+
+    auto worker = [&]() {
+        GeradorHorario gerador(instancia, requisicoes, configGerador);
+
+        while (true) {
+            int tentativa = proximaTentativa.fetch_add(1) + 1;
+            if (tentativa > ultimaNecessaria.load()) {
+                break;
+            }
+            if (config.prazo.esgotado()) {
+                prazoEsgotado.store(true);
+                break;
+            }
+
+            if (callbackTentativa) {
+                std::lock_guard<std::mutex> trava(mutexResultado);
+                callbackTentativa(tentativa);
+            }
+
+            gerador.setAleatorio(Aleatorio::fluxo(semente, tentativa));
+            if (gerador.gerarHorario()) {
+                std::vector<Aula> grade = gerador.getGradeHoraria();
+
+                std::lock_guard<std::mutex> trava(mutexResultado);
+                if (tentativa <= ultimaNecessaria.load() && (!validacao || validacao(grade))) {
+                    gradesPorTentativa.emplace(tentativa, std::move(grade));
+                    if (gradesPorTentativa.size() >= melhoresK) {
+                        int kesima = std::next(gradesPorTentativa.begin(), melhoresK - 1)->first;
+                        ultimaNecessaria.store(std::min(ultimaNecessaria.load(), kesima));
+                    }
+                }
+            }
+            gerador.reset();
+        }
+    };
+
+    if (resultado.threads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(resultado.threads);
+        for (int i = 0; i < resultado.threads; i++) {
+            threads.emplace_back(worker);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    // As K primeiras tentativas bem-sucedidas
+    for (auto& [tentativa, grade] : gradesPorTentativa) {
+        if (resultado.grades.size() >= melhoresK) {
+            break;
+        }
+        resultado.grades.push_back(std::move(grade));
+    }
+
+    resultado.tentativas = ultimaNecessaria.load();
+    resultado.tentativasExecutadas = std::min(proximaTentativa.load() - resultado.threads, maxTentativas);
+    resultado.sucesso = !resultado.grades.empty();
+    resultado.prazoEsgotado = prazoEsgotado.load() && resultado.grades.size() < melhoresK;
+    if (resultado.prazoEsgotado) {
+        resultado.tentativas = resultado.tentativasExecutadas;
+    }
+
+    // Ordenar as grades coletadas pelo custo do SA
+    if (melhoresK > 1 && !resultado.grades.empty()) {
+        std::vector<double> custos;
+        custos.reserve(resultado.grades.size());
+        for (const auto& grade : resultado.grades) {
+            custos.push_back(avaliarGrade(grade));
+        }
+
+        std::vector<size_t> ordem(resultado.grades.size());
+        std::iota(ordem.begin(), ordem.end(), 0);
+        std::stable_sort(ordem.begin(), ordem.end(),
+                         [&](size_t a, size_t b) { return custos[a] < custos[b]; });
+
+        std::vector<std::vector<Aula>> gradesOrdenadas;
+        gradesOrdenadas.reserve(ordem.size());
+        for (size_t i : ordem) {
+            gradesOrdenadas.push_back(std::move(resultado.grades[i]));
+            resultado.custos.push_back(custos[i]);
+        }
+        resultado.grades = std::move(gradesOrdenadas);
+    }
+
+    auto fim = std::chrono::high_resolution_clock::now();
+    resultado.tempoMs = std::chrono::duration<double, std::milli>(fim - inicio).count();
+
+    return resultado;
+}
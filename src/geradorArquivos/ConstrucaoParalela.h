@@ -0,0 +1,81 @@
+#pragma once
+#include "Estruturas.h"
+#include "InstanciaCompilada.h"
+#include "GeradorHorario.h"
+#include "SimulatedAnnealing.h"
+#include "Prazo.h"
+#include <vector>
+#include <memory>
+#include <functional>
+
+// ==============================================================================
+// CONSTRUÇÃO PARALELA (FASE 1 COM MÚLTIPLOS INÍCIOS)
+// ==============================================================================
+
+// Configurações da construção com múltiplos inícios
+struct ConfiguracaoConstrucao {
+    int numThreads = 0;           // 0 = std::thread::hardware_concurrency()
+    int maxTentativas = 100000;   // Total de tentativas somando todos os workers
+    int melhoresK = 1;            // Grades completas a coletar antes de parar
+    Prazo prazo;                  // Nenhuma tentativa começa depois dele; padrão ilimitado
+    ConfiguracaoSA avaliacao;     // Pesos usados para ordenar as grades (K > 1)
+};
+
+// Resultado da construção: grades completas ordenadas da melhor para a pior
+struct ResultadoConstrucao {
+    bool sucesso = false;
+    int tentativas = 0;           // Tentativas até a K-ésima grade (ou o máximo)
+    int tentativasExecutadas = 0; // Tentativas iniciadas por todos os workers
+    int threads = 1;
+    bool prazoEsgotado = false;   // Parou pelo prazo antes de K grades e do máximo de tentativas
+    double tempoMs = 0.0;
+    std::vector<std::vector<Aula>> grades;
+    std::vector<double> custos;   // Custo do SA de cada grade (vazio se K = 1)
+};
+
+// Executa tentativas independentes de gerarHorario() em vários workers. Cada
+// worker tem o próprio GeradorHorario sobre a mesma InstanciaCompilada
+// (somente leitura). As tentativas são distribuídas por um contador atômico
+// e a tentativa t usa o fluxo Aleatorio::fluxo(semente, t), com a semente de
+// ConfiguracaoGerador. Quando há K grades completas, as tentativas
+// posteriores à K-ésima são canceladas e as anteriores ainda em andamento
+// terminam; o resultado são as K primeiras tentativas bem-sucedidas, como na
+// execução sequencial, qualquer que seja o número de threads. Com o prazo
+// esgotado, nenhuma tentativa nova começa e o resultado fica com as grades
+// já encontradas (então passa a depender do relógio).
+class ConstrucaoParalela {
+public:
+    ConstrucaoParalela(
+        std::shared_ptr<const InstanciaCompilada> instancia,
+        std::vector<RequisicaoAlocacao> requisicoes,
+        ConfiguracaoGerador configGerador = ConfiguracaoGerador(),
+        ConfiguracaoConstrucao config = ConfiguracaoConstrucao()
+    );
+
+    ResultadoConstrucao executar();
+
+    // Validação adicional de uma grade completa (ex.: carga por turma/disciplina).
+    // Chamada com exclusão mútua, nunca em paralelo consigo mesma.
+    void setValidacao(std::function<bool(const std::vector<Aula>&)> validacao) {
+        this->validacao = validacao;
+    }
+
+    // Chamado ao iniciar cada tentativa, com o número da tentativa.
+    // Chamado com exclusão mútua, a partir de qualquer worker.
+    void setCallbackTentativa(std::function<void(int)> callback) {
+        callbackTentativa = callback;
+    }
+
+    int getNumThreads() const;
+
+private:
+    std::shared_ptr<const InstanciaCompilada> instancia;
+    std::vector<RequisicaoAlocacao> requisicoes;
+    ConfiguracaoGerador configGerador;
+    ConfiguracaoConstrucao config;
+
+    std::function<bool(const std::vector<Aula>&)> validacao;
+    std::function<void(int)> callbackTentativa;
+
+    double avaliarGrade(const std::vector<Aula>& grade) const;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include "Estruturas.h"
+#include <vector>
+#include <set>
+#include <tuple>
+#include <map>
+#include <string>
+
+// ==============================================================================
+// DADOS DE ENTRADA (EXEMPLO EMBUTIDO E ARQUIVO JSON)
+// ==============================================================================
+
+// Cenário de exemplo embutido
+void setupDadosExemplo(
+    std::vector<Professor>& profs, std::vector<Disciplina>& discs,
+    std::vector<Turma>& turmas, std::vector<Sala>& salas,
+    std::vector<RequisicaoAlocacao>& reqs,
+    std::set<std::tuple<int, int, int>>& disponibilidade,
+    std::map<int, int>& turmaSalaMap);
+
+// Carrega turmas, disciplinas, professores (com disponibilidade), salas e
+// associações turma-sala de um arquivo JSON e gera as requisições
+void carregarDadosJSON(const std::string& arquivo,
+    std::vector<Professor>& profs,
+    std::vector<Disciplina>& discs,
+    std::vector<Turma>& turmas,
+    std::vector<Sala>& salas,
+    std::vector<RequisicaoAlocacao>& reqs,
+    std::set<std::tuple<int, int, int>>& disponibilidade,
+    std::map<int, int>& turmaSalaMap,
+    std::map<int, int>& disponibilidadeTotalProf);
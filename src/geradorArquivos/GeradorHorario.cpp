@@ -1,4 +1,5 @@
 #include "GeradorHorario.h"
+#include "KernelsPenalidade.h"
 #include <algorithm>
 #include <random>
 #include <limits>
@@ -7,6 +8,17 @@
 #include <fstream>
 #include <sstream>
 #include <queue>
+#include <numeric>
+#include <stdexcept>
+#include <bitset>
+
+namespace {
+
+// Peso do impacto de um slot sobre os domínios das pendentes na escolha do
+// slot da construção, em pontos de calcularPontuacaoSlot
+constexpr int PESO_IMPACTO_SLOT = 10;
+
+} // namespace
 
 // Construtor melhorado
 GeradorHorario::GeradorHorario(
@@ -14,38 +26,146 @@ GeradorHorario::GeradorHorario(
     std::vector<Turma> turmas, std::vector<Sala> salas,
     std::vector<RequisicaoAlocacao> reqs,
     std::set<std::tuple<int, int, int>> disponibilidade,
-    std::map<int, int> disponibilidadeTotalProf,
+    std::map<int, int> /*disponibilidadeTotalProf*/,
     std::map<int, int> turmaSalaMapping,
     ConfiguracaoGerador config)
-    : professores(profs), disciplinas(disc), turmas(turmas), salas(salas),
-      requisicoes(reqs), disponibilidadeProfessores(disponibilidade),
-      disponibilidadeTotalProfessores(disponibilidadeTotalProf),
-      turmaSalaMap(turmaSalaMapping), configuracao(config)
+    // disponibilidadeTotalProf é derivada da máscara de disponibilidade compilada
+    : GeradorHorario(std::make_shared<const InstanciaCompilada>(
+                         profs, disc, turmas, salas, disponibilidade, turmaSalaMapping),
+                     std::move(reqs), config)
 {
-    // Inicializa mapas de nomes para facilitar debug e relatórios
-    for (const auto& p : professores) {
-        mapaNomesProfessores[p.id] = p.nome;
-    }
-    for (const auto& d : disciplinas) {
-        mapaNomesDisciplinas[d.id] = d.nome;
-        mapaDisciplinas[d.id] = d;
-    }
-    for (const auto& t : turmas) {
-        mapaNomesTurmas[t.id] = t.nome;
-    }
-    for (const auto& s : salas) {
-        mapaNomesSalas[s.id] = s.nome;
-    }
+}
+
+GeradorHorario::GeradorHorario(
+    std::shared_ptr<const InstanciaCompilada> instancia,
+    std::vector<RequisicaoAlocacao> reqs,
+    ConfiguracaoGerador config)
+    : instancia(std::move(instancia)), requisicoes(std::move(reqs)), configuracao(config),
+      aleatorio(config.semente != 0 ? config.semente : sementeNaoDeterministica())
+{
+    compilarRequisicoes();
+    reconstruirOcupacao();
 
     log("GeradorHorario inicializado com " + std::to_string(requisicoes.size()) + " requisições");
 }
 
+// Traduz as requisições para índices densos, agregando as idênticas em
+// unidades (na ordem da primeira ocorrência). Numa disciplina geminada, a
+// unidade passa a contar blocos de duas aulas e a aula ímpar vai para uma
+// unidade avulsa no fim
+void GeradorHorario::compilarRequisicoes() {
+    requisicoesCompiladas.clear();
+    grupoPorTurmaDisciplina.clear();
+    std::unordered_map<long long, int> unidadePorChave; // grupo * numProfessores + professor
+
+    for (const auto& req : requisicoes) {
+        RequisicaoCompilada rc;
+        rc.professor = instancia->indiceProfessor(req.idProfessor);
+        rc.turma = instancia->indiceTurma(req.idTurma);
+        rc.disciplina = instancia->indiceDisciplina(req.idDisciplina);
+
+        if (rc.professor < 0 || rc.turma < 0 || rc.disciplina < 0) {
+            throw std::invalid_argument("Requisição referencia professor, turma ou disciplina inexistente "
+                                        "(turma " + std::to_string(req.idTurma) +
+                                        ", disciplina " + std::to_string(req.idDisciplina) +
+                                        ", professor " + std::to_string(req.idProfessor) + ")");
+        }
+
+        rc.sala = instancia->salaDaTurma(rc.turma);
+        rc.grupo = grupoPorTurmaDisciplina.emplace(rc.turma * instancia->numDisciplinas() + rc.disciplina,
+                                                   static_cast<int>(grupoPorTurmaDisciplina.size()))
+                       .first->second;
+        rc.quantidade = 1;
+        rc.tamanhoBloco = 1;
+
+        long long chave = static_cast<long long>(rc.grupo) * instancia->numProfessores() + rc.professor;
+        auto [unidade, nova] = unidadePorChave.emplace(chave, static_cast<int>(requisicoesCompiladas.size()));
+        if (nova) {
+            requisicoesCompiladas.push_back(rc);
+        } else {
+            requisicoesCompiladas[unidade->second].quantidade++;
+        }
+    }
+
+    const size_t numUnidades = requisicoesCompiladas.size();
+    for (size_t u = 0; u < numUnidades; u++) {
+        RequisicaoCompilada& unidade = requisicoesCompiladas[u];
+        if (!instancia->disciplinaGeminada(unidade.disciplina) || unidade.quantidade < 2) {
+            continue;
+        }
+        RequisicaoCompilada avulsa = unidade;
+        avulsa.quantidade = unidade.quantidade % 2;
+        unidade.quantidade /= 2;
+        unidade.tamanhoBloco = 2;
+        if (avulsa.quantidade > 0) {
+            requisicoesCompiladas.push_back(avulsa);
+        }
+    }
+}
+
 void GeradorHorario::reset() {
     gradeHoraria.clear();
-    cacheDisponibilidade.clear();
+    reconstruirOcupacao();
     log("Grade horária resetada");
 }
 
+void GeradorHorario::setGradeHoraria(const std::vector<Aula>& novaGrade) {
+    std::vector<AulaCompacta> grade;
+    grade.reserve(novaGrade.size());
+    for (const auto& aula : novaGrade) {
+        grade.push_back(instancia->compactarAula(aula));
+    }
+    gradeHoraria = std::move(grade);
+    reconstruirOcupacao();
+}
+
+std::vector<Aula> GeradorHorario::getGradeHoraria() const {
+    std::vector<Aula> grade;
+    grade.reserve(gradeHoraria.size());
+    for (const auto& aula : gradeHoraria) {
+        grade.push_back(instancia->expandirAula(aula));
+    }
+    return grade;
+}
+
+// Recalcula as máscaras de ocupação a partir da grade atual
+void GeradorHorario::reconstruirOcupacao() {
+    ocupacaoProfessor.assign(instancia->numProfessores(), 0);
+    ocupacaoTurma.assign(instancia->numTurmas(), 0);
+    ocupacaoSala.assign(instancia->numSalas(), 0);
+    ocupacaoGrupo.assign(grupoPorTurmaDisciplina.size(), 0);
+
+    for (const auto& aula : gradeHoraria) {
+        MascaraSlots bit = InstanciaCompilada::bitSlot(aula.slot);
+        ocupacaoProfessor[aula.professor] |= bit;
+        ocupacaoTurma[aula.turma] |= bit;
+        if (aula.sala >= 0) ocupacaoSala[aula.sala] |= bit;
+
+        auto grupo = grupoPorTurmaDisciplina.find(aula.turma * instancia->numDisciplinas() + aula.disciplina);
+        if (grupo != grupoPorTurmaDisciplina.end()) ocupacaoGrupo[grupo->second] |= bit;
+    }
+}
+
+// Marca o slot como ocupado para o professor, a turma e a sala da requisição
+void GeradorHorario::registrarOcupacao(const RequisicaoCompilada& req, int slotId) {
+    MascaraSlots bit = InstanciaCompilada::bitSlot(slotId);
+    ocupacaoProfessor[req.professor] |= bit;
+    ocupacaoTurma[req.turma] |= bit;
+    ocupacaoSala[req.sala] |= bit;
+    ocupacaoGrupo[req.grupo] |= bit;
+}
+
+// Aula compacta da requisição no slot dado
+AulaCompacta GeradorHorario::criarAula(const RequisicaoCompilada& req, const Slot& slot) const {
+    AulaCompacta aula;
+    aula.professor = static_cast<int16_t>(req.professor);
+    aula.turma = static_cast<int16_t>(req.turma);
+    aula.disciplina = static_cast<int16_t>(req.disciplina);
+    aula.sala = static_cast<int16_t>(req.sala);
+    aula.setSlot(slot);
+    return aula;
+}
+
 // Logging melhorado
 void GeradorHorario::log(const std::string& mensagem, bool forcarExibicao) const {
     if (configuracao.verboso || forcarExibicao) {
@@ -61,17 +181,37 @@ void GeradorHorario::logAviso(const std::string& mensagem) const {
     std::cout << "[AVISO] " << mensagem << std::endl;
 }
 
+// Nomes por ID original
+const std::string& GeradorHorario::nomeProfessor(int id) const {
+    static const std::string desconhecido = "???";
+    int p = instancia->indiceProfessor(id);
+    return p >= 0 ? instancia->professor(p).nome : desconhecido;
+}
+
+const std::string& GeradorHorario::nomeDisciplina(int id) const {
+    static const std::string desconhecido = "???";
+    int d = instancia->indiceDisciplina(id);
+    return d >= 0 ? instancia->disciplina(d).nome : desconhecido;
+}
+
+const std::string& GeradorHorario::nomeTurma(int id) const {
+    static const std::string desconhecido = "???";
+    int t = instancia->indiceTurma(id);
+    return t >= 0 ? instancia->turma(t).nome : desconhecido;
+}
+
+const std::string& GeradorHorario::nomeSala(int id) const {
+    static const std::string desconhecido = "???";
+    int s = instancia->indiceSala(id);
+    return s >= 0 ? instancia->sala(s).nome : desconhecido;
+}
+
 // Cálculo de criticidade melhorado
-float GeradorHorario::calcularCriticidade(int idProfessor, int aulasNecessarias) {
-    int disponibilidade = disponibilidadeTotalProfessores.at(idProfessor);
+float GeradorHorario::calcularCriticidade(int professor, int aulasNecessarias) {
+    int disponibilidade = instancia->disponibilidadeTotal(professor);
 
     // Considera também as aulas já alocadas
-    int aulasJaAlocadas = 0;
-    for (const auto& aula : gradeHoraria) {
-        if (aula.idProfessor == idProfessor) {
-            aulasJaAlocadas++;
-        }
-    }
+    int aulasJaAlocadas = std::bitset<NUM_SLOTS>(ocupacaoProfessor[professor]).count();
 
     int disponibilidadeRestante = disponibilidade - aulasJaAlocadas;
     if (disponibilidadeRestante <= 0) return 999.0f; // Criticidade máxima
@@ -80,13 +220,16 @@ float GeradorHorario::calcularCriticidade(int idProfessor, int aulasNecessarias)
 }
 
 // Análise de carga de trabalho melhorada
-void GeradorHorario::analisarCargaDeTrabalho(const std::vector<RequisicaoAlocacao>& requisicoes) {
-    std::map<int, int> aulasPoeProfessor;
-    std::map<int, std::set<int>> turmasPorProfessor;
-
-    for (const auto& req : requisicoes) {
-        aulasPoeProfessor[req.idProfessor]++;
-        turmasPorProfessor[req.idProfessor].insert(req.idTurma);
+void GeradorHorario::analisarCargaDeTrabalho(const std::vector<int>& ordem) {
+    std::vector<int> aulasPorProfessor(instancia->numProfessores(), 0);
+    std::vector<std::set<int>> turmasPorProfessor(instancia->numProfessores());
+
+    int totalAulas = 0;
+    for (int r : ordem) {
+        const auto& req = requisicoesCompiladas[r];
+        aulasPorProfessor[req.professor] += req.aulas();
+        turmasPorProfessor[req.professor].insert(req.turma);
+        totalAulas += req.aulas();
     }
 
     std::cout << "\n=== ANÁLISE DETALHADA DE CARGA DE TRABALHO ===" << std::endl;
@@ -94,21 +237,22 @@ void GeradorHorario::analisarCargaDeTrabalho(const std::vector<RequisicaoAlocaca
 
     // Ordena professores por criticidade
     std::vector<std::pair<int, float>> criticidadePorProfessor;
-    for (const auto& [idProf, qtdAulas] : aulasPoeProfessor) {
-        float criticidade = calcularCriticidade(idProf, qtdAulas);
-        criticidadePorProfessor.push_back({idProf, criticidade});
+    for (int p = 0; p < instancia->numProfessores(); p++) {
+        if (aulasPorProfessor[p] == 0) continue;
+        float criticidade = calcularCriticidade(p, aulasPorProfessor[p]);
+        criticidadePorProfessor.push_back({p, criticidade});
     }
 
     std::sort(criticidadePorProfessor.begin(), criticidadePorProfessor.end(),
               [](const auto& a, const auto& b) { return a.second > b.second; });
 
     // Exibe análise detalhada
-    for (const auto& [idProf, criticidade] : criticidadePorProfessor) {
-        int qtdAulas = aulasPoeProfessor[idProf];
-        int disponibilidade = disponibilidadeTotalProfessores.at(idProf);
-        int numTurmas = turmasPorProfessor[idProf].size();
+    for (const auto& [p, criticidade] : criticidadePorProfessor) {
+        int qtdAulas = aulasPorProfessor[p];
+        int disponibilidade = instancia->disponibilidadeTotal(p);
+        int numTurmas = turmasPorProfessor[p].size();
 
-        std::cout << std::setw(25) << mapaNomesProfessores.at(idProf) << ": "
+        std::cout << std::setw(25) << instancia->professor(p).nome << ": "
                   << std::setw(3) << qtdAulas << " aulas, "
                   << std::setw(3) << disponibilidade << " slots, "
                   << std::setw(2) << numTurmas << " turmas";
@@ -126,47 +270,12 @@ void GeradorHorario::analisarCargaDeTrabalho(const std::vector<RequisicaoAlocaca
     }
 
     std::cout << "\nResumo: "
-              << requisicoes.size() << " aulas para alocar, "
-              << professores.size() << " professores disponíveis" << std::endl;
-}
-
-// Obter slots ordenados por qualidade
-std::vector<Slot> GeradorHorario::obterSlotsOrdenados(const RequisicaoAlocacao& req) {
-    std::vector<std::pair<Slot, int>> slotsComPontuacao;
-
-    auto it = turmaSalaMap.find(req.idTurma);
-    if (it == turmaSalaMap.end()) {
-        logErro("Turma " + std::to_string(req.idTurma) + " sem sala associada!");
-        return {};
-    }
-    int idSalaDaTurma = it->second;
-
-    // Avaliar todos os slots possíveis
-    for (int dia = 0; dia < 5; ++dia) {
-        for (int hora = 0; hora < 6; ++hora) {
-            Slot slotAtual = { dia, hora };
-            if (verificarDisponibilidade(req.idTurma, req.idProfessor, idSalaDaTurma, slotAtual)) {
-                int pontuacao = calcularPontuacaoSlot(req, slotAtual);
-                slotsComPontuacao.push_back({slotAtual, pontuacao});
-            }
-        }
-    }
-
-    // Ordenar por pontuação (maior = melhor)
-    std::sort(slotsComPontuacao.begin(), slotsComPontuacao.end(),
-              [](const auto& a, const auto& b) { return a.second > b.second; });
-
-    // Extrair apenas os slots
-    std::vector<Slot> slotsOrdenados;
-    for (const auto& [slot, pontuacao] : slotsComPontuacao) {
-        slotsOrdenados.push_back(slot);
-    }
-
-    return slotsOrdenados;
+              << totalAulas << " aulas para alocar, "
+              << instancia->numProfessores() << " professores disponíveis" << std::endl;
 }
 
 // Calcular pontuação de um slot (quanto maior, melhor)
-int GeradorHorario::calcularPontuacaoSlot(const RequisicaoAlocacao& req, const Slot& slot) {
+int GeradorHorario::calcularPontuacaoSlot(const RequisicaoCompilada& req, const Slot& slot) {
     int pontuacao = 100; // Base
 
     // Penalizar horários extremos
@@ -176,38 +285,25 @@ int GeradorHorario::calcularPontuacaoSlot(const RequisicaoAlocacao& req, const S
         }
     }
 
-    // Bonificar aulas consecutivas da mesma disciplina
-    for (const auto& aula : gradeHoraria) {
-        if (aula.idTurma == req.idTurma && aula.idDisciplina == req.idDisciplina) {
-            if (aula.slot.dia == slot.dia) {
-                if (abs(aula.slot.hora - slot.hora) == 1) {
-                    pontuacao += 30; // Aula adjacente
-                }
-            }
-        }
-    }
+    MascaraSlots bit = InstanciaCompilada::bitSlot(slot.getId());
+    MascaraSlots mesmoDia = MASCARA_DIA << (slot.dia * NUM_HORARIOS);
+
+    // Bonificar aulas consecutivas da mesma disciplina (horas vizinhas no dia)
+    MascaraSlots vizinhos = ((bit << 1) | (bit >> 1)) & mesmoDia;
+    pontuacao += 30 * __builtin_popcount(ocupacaoGrupo[req.grupo] & vizinhos);
 
     // Verificar distribuição semanal
     if (configuracao.distribuirAulasUniformemente) {
-        int aulasNoDia = 0;
-        for (const auto& aula : gradeHoraria) {
-            if (aula.idTurma == req.idTurma && aula.slot.dia == slot.dia) {
-                aulasNoDia++;
-            }
-        }
         // Penalizar dias muito carregados
+        int aulasNoDia = __builtin_popcount(ocupacaoTurma[req.turma] & mesmoDia);
         pontuacao -= aulasNoDia * 5;
     }
 
-    // Verificar janelas do professor
+    // Verificar janelas do professor (só o dia do slot muda)
     if (configuracao.priorizarMinimoJanelas) {
-        int janelasAntes = contarJanelasHorario(req.idProfessor);
-
-        // Simular adição temporária
-        Aula aulaTemp = { req.idProfessor, req.idDisciplina, req.idTurma, 0, slot };
-        gradeHoraria.push_back(aulaTemp);
-        int janelasDepois = contarJanelasHorario(req.idProfessor);
-        gradeHoraria.pop_back();
+        MascaraSlots ocupacao = ocupacaoProfessor[req.professor];
+        int janelasAntes = janelasDia(ocupacao, slot.dia);
+        int janelasDepois = janelasDia(ocupacao | bit, slot.dia);
 
         if (janelasDepois > janelasAntes) {
             pontuacao -= (janelasDepois - janelasAntes) * 25;
@@ -217,301 +313,265 @@ int GeradorHorario::calcularPontuacaoSlot(const RequisicaoAlocacao& req, const S
     return pontuacao;
 }
 
-// Geração de horário melhorada
+// Construção com propagação de restrições: cada unidade com itens restantes
+// mantém o seu domínio (slots livres para professor, turma e sala, ou
+// inícios de bloco com os dois slots livres numa unidade geminada). A cada
+// passo é alocado um item da unidade de menor folga (empates sorteados), no
+// slot de maior pontuação, e os slots ocupados são retirados dos domínios
+// das unidades com o mesmo professor, turma ou sala. Um domínio menor que os
+// itens restantes da unidade encerra a tentativa.
 bool GeradorHorario::gerarHorario() {
     auto inicio = std::chrono::high_resolution_clock::now();
 
-    std::vector<RequisicaoAlocacao> requisicoesParaTentar = this->requisicoes;
-
     // Análise inicial
-    analisarCargaDeTrabalho(requisicoesParaTentar);
-
-    // Calcula criticidade para cada requisição
-    std::map<int, int> aulasPoeProfessor;
-    for (const auto& req : requisicoesParaTentar) {
-        aulasPoeProfessor[req.idProfessor]++;
+    if (configuracao.verboso) {
+        std::vector<int> todas(requisicoesCompiladas.size());
+        std::iota(todas.begin(), todas.end(), 0);
+        analisarCargaDeTrabalho(todas);
     }
 
-    // Ordena por criticidade com estratégia melhorada
-    std::sort(requisicoesParaTentar.begin(), requisicoesParaTentar.end(),
-        [&](const RequisicaoAlocacao& a, const RequisicaoAlocacao& b) {
-            float critA = calcularCriticidade(a.idProfessor, aulasPoeProfessor[a.idProfessor]);
-            float critB = calcularCriticidade(b.idProfessor, aulasPoeProfessor[b.idProfessor]);
-
-            // Se criticidade muito diferente, usa ela
-            if (std::abs(critA - critB) > 0.1) {
-                return critA > critB;
-            }
-
-            // Priorizar disciplinas com mais aulas (para facilitar consecutivas)
-            auto discA = mapaDisciplinas.find(a.idDisciplina);
-            auto discB = mapaDisciplinas.find(b.idDisciplina);
-            if (discA != mapaDisciplinas.end() && discB != mapaDisciplinas.end()) {
-                int totalA = 0, totalB = 0;
-                for (const auto& [turma, qtd] : discA->second.aulasPorTurma) {
-                    totalA += qtd;
-                }
-                for (const auto& [turma, qtd] : discB->second.aulasPorTurma) {
-                    totalB += qtd;
-                }
-                if (totalA != totalB) {
-                    return totalA > totalB;
-                }
-            }
-
-            // Senão, usa disponibilidade absoluta como desempate
-            return disponibilidadeTotalProfessores.at(a.idProfessor) <
-                   disponibilidadeTotalProfessores.at(b.idProfessor);
-        });
-
-    // Adiciona aleatoriedade controlada
-    std::random_device rd;
-    std::mt19937 g(rd());
-
-    size_t inicio_grupo = 0;
-    while (inicio_grupo < requisicoesParaTentar.size()) {
-        size_t fim_grupo = inicio_grupo + 1;
+    EstadoPropagacao estado;
+    if (!inicializarDominios(estado)) {
+        return false;
+    }
 
-        float critInicio = calcularCriticidade(requisicoesParaTentar[inicio_grupo].idProfessor,
-                                              aulasPoeProfessor[requisicoesParaTentar[inicio_grupo].idProfessor]);
+    size_t total = 0;
+    for (const auto& req : requisicoesCompiladas) {
+        total += req.aulas();
+    }
+    if (configuracao.verboso) {
+        std::cout << "\n=== INICIANDO ALOCAÇÃO COM PROPAGAÇÃO ===" << std::endl;
+        std::cout << "Total de aulas a alocar: " << total << std::endl;
+    }
 
-        while (fim_grupo < requisicoesParaTentar.size()) {
-            float critFim = calcularCriticidade(requisicoesParaTentar[fim_grupo].idProfessor,
-                                               aulasPoeProfessor[requisicoesParaTentar[fim_grupo].idProfessor]);
-            if (std::abs(critInicio - critFim) > 0.1) break;
-            fim_grupo++;
+    size_t alocadas = 0;
+    size_t proximoProgresso = 10;
+    int esvaziada = -1; // Unidade com menos slots no domínio que itens restantes
+    while (alocadas < total) {
+        int r = selecionarMaisRestrita(estado);
+        if (r < 0) {
+            break; // Baldes vazios com aulas por alocar: falha
         }
 
-        if (fim_grupo - inicio_grupo > 1) {
-            std::shuffle(requisicoesParaTentar.begin() + inicio_grupo,
-                        requisicoesParaTentar.begin() + fim_grupo, g);
+        const auto& req = requisicoesCompiladas[r];
+        int slotInicial = escolherSlot(estado, r);
+        for (int slotId = slotInicial; slotId < slotInicial + req.tamanhoBloco; slotId++) {
+            gradeHoraria.push_back(criarAula(req, Slot::fromId(slotId)));
+            registrarOcupacao(req, slotId);
         }
+        estado.restantes[r]--;
+        alocadas += req.tamanhoBloco;
 
-        inicio_grupo = fim_grupo;
-    }
-
-    std::cout << "\n=== INICIANDO ALOCAÇÃO INTELIGENTE ===" << std::endl;
-    std::cout << "Total de aulas a alocar: " << requisicoesParaTentar.size() << std::endl;
-
-    // Tenta alocar todas as requisições
-    int alocadas = 0;
-    int falhas = 0;
-    std::map<StatusAlocacao, int> contagemStatus;
-
-    for (size_t i = 0; i < requisicoesParaTentar.size(); i++) {
-        const auto& req = requisicoesParaTentar[i];
-        StatusAlocacao status = tentarAlocarRequisicao(req);
+        MascaraSlots ocupados = InstanciaCompilada::bitSlot(slotInicial);
+        if (req.tamanhoBloco == 2) ocupados = slotsGeminada(ocupados);
+        esvaziada = propagarAlocacao(estado, r, ocupados);
 
-        contagemStatus[status]++;
-
-        if (status == StatusAlocacao::SUCESSO) {
-            alocadas++;
+        if (alocadas >= proximoProgresso) {
+            proximoProgresso += 10;
             // Callback de progresso
-            if (callbackProgresso && i % 10 == 0) {
-                callbackProgresso(i + 1, requisicoesParaTentar.size());
+            if (callbackProgresso) {
+                callbackProgresso(alocadas, total);
             }
             // Mostra progresso
-            if (alocadas % 10 == 0) {
-                std::cout << "." << std::flush;
-            }
-        } else {
-            falhas++;
             if (configuracao.verboso) {
-                std::cout << "\nFalha ao alocar "
-                          << mapaNomesDisciplinas.at(req.idDisciplina)
-                          << " para " << mapaNomesTurmas.at(req.idTurma)
-                          << " com " << mapaNomesProfessores.at(req.idProfessor);
-
-                switch (status) {
-                    case StatusAlocacao::FALHA_SEM_SLOTS_DISPONIVEIS:
-                        std::cout << " - Sem slots disponíveis";
-                        break;
-                    case StatusAlocacao::FALHA_PROFESSOR_INDISPONIVEL:
-                        std::cout << " - Professor indisponível";
-                        break;
-                    case StatusAlocacao::FALHA_TURMA_OCUPADA:
-                        std::cout << " - Turma ocupada";
-                        break;
-                    case StatusAlocacao::FALHA_SALA_OCUPADA:
-                        std::cout << " - Sala ocupada";
-                        break;
-                    default:
-                        std::cout << " - Erro desconhecido";
-                }
-                std::cout << std::endl;
+                std::cout << "." << std::flush;
             }
+        }
 
-            // Se muitas falhas consecutivas, pode ser problema grave
-            if (falhas > 10) {
-                logErro("Muitas falhas consecutivas. Verificar dados de entrada.");
-                return false;
-            }
+        if (esvaziada >= 0) {
+            break;
         }
     }
 
     auto fim = std::chrono::high_resolution_clock::now();
     auto duracao = std::chrono::duration_cast<std::chrono::milliseconds>(fim - inicio);
 
-    std::cout << "\n\n=== RESULTADO DA ALOCAÇÃO ===" << std::endl;
-    std::cout << "Aulas alocadas: " << alocadas << "/" << requisicoesParaTentar.size() << std::endl;
-    std::cout << "Taxa de sucesso: " << std::fixed << std::setprecision(1)
-              << (alocadas * 100.0 / requisicoesParaTentar.size()) << "%" << std::endl;
-    std::cout << "Tempo de processamento: " << duracao.count() << "ms" << std::endl;
-
-    // Estatísticas de falhas
-    if (!contagemStatus.empty()) {
-        std::cout << "\nDetalhamento de status:" << std::endl;
-        for (const auto& [status, count] : contagemStatus) {
-            if (status != StatusAlocacao::SUCESSO && count > 0) {
-                std::cout << "  ";
-                switch (status) {
-                    case StatusAlocacao::FALHA_SEM_SLOTS_DISPONIVEIS:
-                        std::cout << "Sem slots disponíveis: ";
-                        break;
-                    case StatusAlocacao::FALHA_PROFESSOR_INDISPONIVEL:
-                        std::cout << "Professor indisponível: ";
-                        break;
-                    case StatusAlocacao::FALHA_TURMA_OCUPADA:
-                        std::cout << "Turma ocupada: ";
-                        break;
-                    case StatusAlocacao::FALHA_SALA_OCUPADA:
-                        std::cout << "Sala ocupada: ";
-                        break;
-                    default:
-                        std::cout << "Outros: ";
-                }
-                std::cout << count << std::endl;
-            }
+    if (configuracao.verboso) {
+        if (esvaziada >= 0) {
+            const auto& req = requisicoesCompiladas[esvaziada];
+            std::cout << "\nSem slots disponíveis para "
+                      << instancia->disciplina(req.disciplina).nome
+                      << " para " << instancia->turma(req.turma).nome
+                      << " com " << instancia->professor(req.professor).nome << std::endl;
         }
-    }
 
-    return alocadas == requisicoesParaTentar.size();
-}
-
-// Tentativa de alocação melhorada
-StatusAlocacao GeradorHorario::tentarAlocarRequisicao(const RequisicaoAlocacao& req) {
-    // Obtém a sala específica da turma
-    auto it = turmaSalaMap.find(req.idTurma);
-    if (it == turmaSalaMap.end()) {
-        logErro("Turma " + std::to_string(req.idTurma) + " não tem sala associada!");
-        return StatusAlocacao::FALHA_SALA_OCUPADA;
+        std::cout << "\n\n=== RESULTADO DA ALOCAÇÃO ===" << std::endl;
+        std::cout << "Aulas alocadas: " << alocadas << "/" << total << std::endl;
+        std::cout << "Taxa de sucesso: " << std::fixed << std::setprecision(1)
+                  << (total > 0 ? alocadas * 100.0 / total : 100.0) << "%" << std::endl;
+        std::cout << "Tempo de processamento: " << duracao.count() << "ms" << std::endl;
     }
-    int idSalaDaTurma = it->second;
-
-    // Busca slots ordenados por qualidade
-    std::vector<Slot> slotsOrdenados = obterSlotsOrdenados(req);
-
-    if (slotsOrdenados.empty()) {
-        return StatusAlocacao::FALHA_SEM_SLOTS_DISPONIVEIS;
-    }
-
-    // Tenta alocar no melhor slot disponível
-    for (const auto& slot : slotsOrdenados) {
-        // Verificação dupla (cache pode estar desatualizado)
-        if (verificarDisponibilidade(req.idTurma, req.idProfessor, idSalaDaTurma, slot)) {
-            // Cria a aula
-            Aula novaAula = { req.idProfessor, req.idDisciplina, req.idTurma, idSalaDaTurma, slot };
-            gradeHoraria.push_back(novaAula);
 
-            // Invalida cache relevante
-            cacheDisponibilidade.clear();
+    return alocadas == total;
+}
 
-            return StatusAlocacao::SUCESSO;
+// Domínios iniciais e índices das unidades por professor, turma e sala.
+// Falha se alguma turma não tem sala associada ou se alguma unidade já
+// começa com menos slots no domínio que itens.
+bool GeradorHorario::inicializarDominios(EstadoPropagacao& estado) {
+    const int n = static_cast<int>(requisicoesCompiladas.size());
+    estado.dominio.assign(n, 0);
+    estado.restantes.assign(n, 0);
+    estado.porProfessor.assign(instancia->numProfessores(), {});
+    estado.porTurma.assign(instancia->numTurmas(), {});
+    estado.porSala.assign(instancia->numSalas(), {});
+
+    for (int r = 0; r < n; r++) {
+        const auto& req = requisicoesCompiladas[r];
+        if (req.sala < 0) {
+            logErro("Turma " + std::to_string(instancia->turma(req.turma).id) + " não tem sala associada!");
+            return false;
         }
-    }
 
-    // Analisa por que falhou
-    if (!slotsOrdenados.empty()) {
-        // Tinha slots mas nenhum funcionou - provavelmente conflito
-        for (const auto& aula : gradeHoraria) {
-            if (aula.idProfessor == req.idProfessor) {
-                return StatusAlocacao::FALHA_PROFESSOR_INDISPONIVEL;
-            }
-            if (aula.idTurma == req.idTurma) {
-                return StatusAlocacao::FALHA_TURMA_OCUPADA;
+        estado.dominio[r] = obterDominio(req);
+        estado.restantes[r] = req.quantidade;
+        if (estado.folga(r) < 0) {
+            if (configuracao.verboso) {
+                std::cout << "\nSem slots disponíveis para "
+                          << instancia->disciplina(req.disciplina).nome
+                          << " para " << instancia->turma(req.turma).nome
+                          << " com " << instancia->professor(req.professor).nome << std::endl;
             }
+            return false;
         }
-        return StatusAlocacao::FALHA_SALA_OCUPADA;
+        estado.porProfessor[req.professor].push_back(r);
+        estado.porTurma[req.turma].push_back(r);
+        estado.porSala[req.sala].push_back(r);
+        estado.baldes[estado.folga(r)].push_back(r);
     }
-
-    return StatusAlocacao::FALHA_SEM_SLOTS_DISPONIVEIS;
+    return true;
 }
 
-// Verificação de disponibilidade com cache
-bool GeradorHorario::verificarDisponibilidade(int idTurma, int idProfessor, int idSala, Slot slot) {
-    // Verifica cache primeiro
-    auto chaveCache = std::make_tuple(idProfessor, slot.dia, slot.hora);
-    auto itCache = cacheDisponibilidade.find(chaveCache);
-    if (itCache != cacheDisponibilidade.end() && !itCache->second) {
-        return false; // Já sabemos que não está disponível
+// Retira a unidade com itens restantes de menor folga, sorteando entre as de
+// mesma folga (o sorteio diferencia as tentativas da construção paralela).
+// Devolve -1 se não há nenhuma. Folga negativa não chega aos baldes:
+// encerra a tentativa em inicializarDominios ou propagarAlocacao. Após
+// alocar, propagarAlocacao devolve a unidade ao balde se ainda restam itens
+// (o slot alocado sai do próprio domínio, pela turma)
+int GeradorHorario::selecionarMaisRestrita(EstadoPropagacao& estado) {
+    for (int folga = 0; folga < static_cast<int>(estado.baldes.size()); folga++) {
+        auto& balde = estado.baldes[folga];
+        while (!balde.empty()) {
+            size_t k = aleatorio.inteiro(static_cast<uint32_t>(balde.size()));
+            int r = balde[k];
+            balde[k] = balde.back();
+            balde.pop_back();
+
+            if (estado.restantes[r] > 0 && estado.folga(r) == folga) {
+                return r;
+            }
+        }
     }
+    return -1;
+}
 
-    // Verifica se o professor está disponível neste horário
-    if (disponibilidadeProfessores.find({ idProfessor, slot.dia, slot.hora }) ==
-        disponibilidadeProfessores.end()) {
-        cacheDisponibilidade[chaveCache] = false;
-        return false;
+// Slot de maior pontuação no domínio, descontado o impacto da escolha sobre
+// as unidades do mesmo professor ou turma que ainda contam com ele (valor
+// menos restritivo): cada item restante pesa mais quanto menor for o
+// domínio da sua unidade. Num bloco geminado, o início cujos dois slots
+// somam a maior pontuação. Em caso de empate, o primeiro slot.
+int GeradorHorario::escolherSlot(const EstadoPropagacao& estado, int requisicao) {
+    const auto& req = requisicoesCompiladas[requisicao];
+
+    int impacto[NUM_SLOTS] = {};
+    for (const auto* vizinhas : {&estado.porProfessor[req.professor], &estado.porTurma[req.turma]}) {
+        for (int r : *vizinhas) {
+            MascaraSlots dominio = estado.dominio[r];
+            if (estado.restantes[r] == 0 || dominio == 0) {
+                continue;
+            }
+            int peso = estado.restantes[r] * (NUM_SLOTS / __builtin_popcount(dominio));
+            MascaraSlots cobertos = requisicoesCompiladas[r].tamanhoBloco == 2 ? slotsGeminada(dominio) : dominio;
+            for (int slotId = 0; slotId < NUM_SLOTS; ++slotId) {
+                if (cobertos & InstanciaCompilada::bitSlot(slotId)) {
+                    impacto[slotId] += peso;
+                }
+            }
+        }
     }
 
-    // Verifica conflitos na grade já construída
-    for (const auto& aula : gradeHoraria) {
-        if (aula.slot.dia == slot.dia && aula.slot.hora == slot.hora) {
-            // Professor não pode estar em dois lugares ao mesmo tempo
-            if (aula.idProfessor == idProfessor) {
-                return false;
-            }
-            // Turma não pode ter duas aulas ao mesmo tempo
-            if (aula.idTurma == idTurma) {
-                return false;
+    const MascaraSlots dominio = estado.dominio[requisicao];
+    int melhorSlot = -1;
+    int melhorPontuacao = std::numeric_limits<int>::min();
+    for (int slotId = 0; slotId < NUM_SLOTS; ++slotId) {
+        if (dominio & InstanciaCompilada::bitSlot(slotId)) {
+            int pontuacao = 0;
+            for (int s = slotId; s < slotId + req.tamanhoBloco; s++) {
+                pontuacao += calcularPontuacaoSlot(req, Slot::fromId(s)) - PESO_IMPACTO_SLOT * impacto[s];
             }
-            // Sala não pode ser usada por duas turmas ao mesmo tempo
-            if (aula.idSala == idSala) {
-                return false;
+            if (pontuacao > melhorPontuacao) {
+                melhorPontuacao = pontuacao;
+                melhorSlot = slotId;
             }
         }
     }
-
-    cacheDisponibilidade[chaveCache] = true;
-    return true;
+    return melhorSlot;
 }
-// Contar janelas de horário de um professor
-int GeradorHorario::contarJanelasHorario(int idProfessor) const {
-    int totalJanelas = 0;
 
-    for (int dia = 0; dia < 5; dia++) {
-        std::vector<int> horariosNoDia;
-
-        for (const auto& aula : gradeHoraria) {
-            if (aula.idProfessor == idProfessor && aula.slot.dia == dia) {
-                horariosNoDia.push_back(aula.slot.hora);
+// Retira os slots ocupados dos domínios das unidades que compartilham
+// professor, turma ou sala com a alocada (numa unidade geminada, os inícios
+// de bloco que cobririam algum deles). Devolve a primeira unidade cujo
+// domínio ficou menor que os seus itens restantes, ou -1.
+int GeradorHorario::propagarAlocacao(EstadoPropagacao& estado, int requisicao, MascaraSlots ocupados) {
+    const auto& req = requisicoesCompiladas[requisicao];
+    const MascaraSlots iniciosOcupados = ocupados | (ocupados >> 1);
+
+    for (const auto* vizinhas : {&estado.porProfessor[req.professor],
+                                 &estado.porTurma[req.turma],
+                                 &estado.porSala[req.sala]}) {
+        for (int r : *vizinhas) {
+            MascaraSlots retirados = requisicoesCompiladas[r].tamanhoBloco == 2 ? iniciosOcupados : ocupados;
+            if (estado.restantes[r] == 0 || !(estado.dominio[r] & retirados)) {
+                continue;
             }
-        }
-
-        if (horariosNoDia.size() > 1) {
-            std::sort(horariosNoDia.begin(), horariosNoDia.end());
-
-            for (size_t i = 1; i < horariosNoDia.size(); i++) {
-                int janela = horariosNoDia[i] - horariosNoDia[i-1] - 1;
-                if (janela > 0) {
-                    totalJanelas += janela;
-                }
+            estado.dominio[r] &= ~retirados;
+            int folga = estado.folga(r);
+            if (folga < 0) {
+                return r;
             }
+            estado.baldes[folga].push_back(r);
         }
     }
+    return -1;
+}
+
+// Verificação de disponibilidade: professor disponível e slot livre
+// para professor, turma e sala
+bool GeradorHorario::verificarDisponibilidade(const RequisicaoCompilada& req, Slot slot) {
+    return (obterSlotsLivres(req) >> slot.getId()) & 1u;
+}
 
-    return totalJanelas;
+// Slots em que a requisição pode ser alocada: disponibilidade do professor
+// menos os slots já ocupados pelo professor, pela turma ou pela sala
+MascaraSlots GeradorHorario::obterSlotsLivres(const RequisicaoCompilada& req) const {
+    return instancia->disponibilidadeProfessor(req.professor) &
+           ~ocupacaoProfessor[req.professor] &
+           ~ocupacaoTurma[req.turma] &
+           ~ocupacaoSala[req.sala];
+}
+
+// Domínio de um item da unidade: os slots livres, ou os inícios de bloco
+// com os dois slots livres numa unidade geminada
+MascaraSlots GeradorHorario::obterDominio(const RequisicaoCompilada& req) const {
+    MascaraSlots livres = obterSlotsLivres(req);
+    return req.tamanhoBloco == 2 ? iniciosGeminada(livres) : livres;
+}
+
+// Contar janelas de horário de um professor
+int GeradorHorario::contarJanelasHorario(int professor) const {
+    return totalJanelas(ocupacaoProfessor[professor]);
 }
 
 // Contar aulas consecutivas de uma disciplina
-int GeradorHorario::contarAulasConsecutivas(int idTurma, int idDisciplina) const {
+int GeradorHorario::contarAulasConsecutivas(int turma, int disciplina) const {
     int totalConsecutivas = 0;
 
     for (int dia = 0; dia < 5; dia++) {
         std::vector<int> horariosNoDia;
 
         for (const auto& aula : gradeHoraria) {
-            if (aula.idTurma == idTurma && aula.idDisciplina == idDisciplina && aula.slot.dia == dia) {
-                horariosNoDia.push_back(aula.slot.hora);
+            if (aula.turma == turma && aula.disciplina == disciplina && aula.dia() == dia) {
+                horariosNoDia.push_back(aula.hora());
             }
         }
 
@@ -537,9 +597,10 @@ std::map<int, std::vector<int>> GeradorHorario::obterDistribuicaoSemanal(int idT
         distribuicao[dia] = std::vector<int>();
     }
 
+    int turma = instancia->indiceTurma(idTurma);
     for (const auto& aula : gradeHoraria) {
-        if (aula.idTurma == idTurma) {
-            distribuicao[aula.slot.dia].push_back(aula.slot.hora);
+        if (aula.turma == turma) {
+            distribuicao[aula.dia()].push_back(aula.hora());
         }
     }
 
@@ -559,25 +620,27 @@ EstatisticasGrade GeradorHorario::obterEstatisticasDetalhadas() const {
     stats.janelasHorario = 0;
     stats.conflitos = 0;
 
+    const std::vector<Aula> grade = getGradeHoraria();
+
     // Aulas por turma
-    for (const auto& aula : gradeHoraria) {
+    for (const auto& aula : grade) {
         stats.aulasPorTurma[aula.idTurma]++;
         stats.aulasPorProfessor[aula.idProfessor]++;
         stats.aulasPorDia[aula.slot.dia]++;
     }
 
     // Janelas de horário total
-    for (const auto& prof : professores) {
-        stats.janelasHorario += contarJanelasHorario(prof.id);
+    for (int p = 0; p < instancia->numProfessores(); p++) {
+        stats.janelasHorario += contarJanelasHorario(p);
     }
 
     // Ocupação de salas
     std::map<int, std::set<std::pair<int, int>>> slotsOcupadosPorSala;
-    for (const auto& aula : gradeHoraria) {
+    for (const auto& aula : grade) {
         slotsOcupadosPorSala[aula.idSala].insert({aula.slot.dia, aula.slot.hora});
     }
 
-    for (const auto& sala : salas) {
+    for (const auto& sala : instancia->getSalas()) {
         float ocupacao = slotsOcupadosPorSala[sala.id].size() / 30.0f * 100;
         stats.ocupacaoSalas[sala.id] = ocupacao;
     }
@@ -594,7 +657,7 @@ bool GeradorHorario::validarGradeCompleta() const {
         contagemRequisicoes[{req.idTurma, req.idDisciplina, req.idProfessor}]++;
     }
 
-    for (const auto& aula : gradeHoraria) {
+    for (const auto& aula : getGradeHoraria()) {
         auto chave = std::make_tuple(aula.idTurma, aula.idDisciplina, aula.idProfessor);
         if (contagemRequisicoes.find(chave) != contagemRequisicoes.end()) {
             contagemRequisicoes[chave]--;
@@ -617,12 +680,12 @@ bool GeradorHorario::validarGradeCompleta() const {
 bool GeradorHorario::verificarConflitosProfessor() const {
     std::map<std::tuple<int, int, int>, int> ocupacaoProfessor;
 
-    for (const auto& aula : gradeHoraria) {
+    for (const auto& aula : getGradeHoraria()) {
         auto chave = std::make_tuple(aula.idProfessor, aula.slot.dia, aula.slot.hora);
         ocupacaoProfessor[chave]++;
 
         if (ocupacaoProfessor[chave] > 1) {
-            logErro("Professor " + mapaNomesProfessores.at(aula.idProfessor) +
+            logErro("Professor " + nomeProfessor(aula.idProfessor) +
                    " tem conflito no dia " + std::to_string(aula.slot.dia) +
                    " hora " + std::to_string(aula.slot.hora));
             return false;
@@ -636,12 +699,12 @@ bool GeradorHorario::verificarConflitosProfessor() const {
 bool GeradorHorario::verificarConflitosTurma() const {
     std::map<std::tuple<int, int, int>, int> ocupacaoTurma;
 
-    for (const auto& aula : gradeHoraria) {
+    for (const auto& aula : getGradeHoraria()) {
         auto chave = std::make_tuple(aula.idTurma, aula.slot.dia, aula.slot.hora);
         ocupacaoTurma[chave]++;
 
         if (ocupacaoTurma[chave] > 1) {
-            logErro("Turma " + mapaNomesTurmas.at(aula.idTurma) +
+            logErro("Turma " + nomeTurma(aula.idTurma) +
                    " tem conflito no dia " + std::to_string(aula.slot.dia) +
                    " hora " + std::to_string(aula.slot.hora));
             return false;
@@ -655,21 +718,16 @@ bool GeradorHorario::verificarConflitosTurma() const {
 bool GeradorHorario::verificarConflitosSala() const {
     std::map<std::tuple<int, int, int>, std::vector<int>> ocupacaoSala;
 
-    for (const auto& aula : gradeHoraria) {
+    for (const auto& aula : getGradeHoraria()) {
         auto chave = std::make_tuple(aula.idSala, aula.slot.dia, aula.slot.hora);
         ocupacaoSala[chave].push_back(aula.idTurma);
 
         // Verificar se é sala compartilhada
-        bool salaCompartilhada = false;
-        for (const auto& sala : salas) {
-            if (sala.id == aula.idSala && sala.compartilhada) {
-                salaCompartilhada = true;
-                break;
-            }
-        }
+        int indiceSala = instancia->indiceSala(aula.idSala);
+        bool salaCompartilhada = indiceSala >= 0 && instancia->salaCompartilhada(indiceSala);
 
         if (!salaCompartilhada && ocupacaoSala[chave].size() > 1) {
-            logErro("Sala " + mapaNomesSalas.at(aula.idSala) +
+            logErro("Sala " + nomeSala(aula.idSala) +
                    " (não compartilhada) tem conflito no dia " + std::to_string(aula.slot.dia) +
                    " hora " + std::to_string(aula.slot.hora));
             return false;
@@ -704,8 +762,9 @@ std::vector<std::string> GeradorHorario::obterProblemasGrade() const {
     }
 
     // Verificar janelas excessivas
-    for (const auto& prof : professores) {
-        int janelas = contarJanelasHorario(prof.id);
+    for (int p = 0; p < instancia->numProfessores(); p++) {
+        const auto& prof = instancia->professor(p);
+        int janelas = contarJanelasHorario(p);
         if (janelas > 5) {
             problemas.push_back("Professor " + prof.nome + " tem " +
                                std::to_string(janelas) + " janelas de horário");
@@ -721,6 +780,15 @@ std::vector<std::string> GeradorHorario::obterProblemasGrade() const {
         }
     }
 
+    // Verificar blocos geminados (aulas da unidade em pares seguidos no mesmo dia)
+    for (const auto& req : requisicoesCompiladas) {
+        MascaraSlots ocupacao = ocupacaoGrupo[req.grupo];
+        if (req.tamanhoBloco == 2 && blocosGeminados(ocupacao) < __builtin_popcount(ocupacao) / 2) {
+            problemas.push_back("Disciplina " + instancia->disciplina(req.disciplina).nome + " da turma " +
+                                instancia->turma(req.turma).nome + " tem aulas geminadas separadas");
+        }
+    }
+
     return problemas;
 }
 
@@ -738,7 +806,7 @@ void GeradorHorario::mostrarEstatisticasGrade() {
     // Ocupação por turma
     std::cout << "\nOcupação por turma:" << std::endl;
     for (const auto& [idTurma, qtd] : stats.aulasPorTurma) {
-        std::cout << "  " << std::setw(15) << mapaNomesTurmas[idTurma]
+        std::cout << "  " << std::setw(15) << nomeTurma(idTurma)
                   << ": " << std::setw(2) << qtd << "/30 slots ("
                   << std::fixed << std::setprecision(1)
                   << (qtd * 100.0 / 30) << "%)" << std::endl;
@@ -771,9 +839,9 @@ void GeradorHorario::mostrarEstatisticasGrade() {
     std::vector<std::pair<std::string, float>> utilizacaoProfessores;
 
     for (const auto& [idProf, aulas] : stats.aulasPorProfessor) {
-        int disponivel = disponibilidadeTotalProfessores[idProf];
+        int disponivel = instancia->disponibilidadeTotal(instancia->indiceProfessor(idProf));
         float utilizacao = (float)aulas / disponivel * 100;
-        utilizacaoProfessores.push_back({mapaNomesProfessores[idProf], utilizacao});
+        utilizacaoProfessores.push_back({nomeProfessor(idProf), utilizacao});
     }
 
     // Ordenar por utilização
@@ -799,9 +867,9 @@ void GeradorHorario::mostrarEstatisticasGrade() {
     std::cout << "  Janelas de horário totais: " << stats.janelasHorario << std::endl;
 
     int totalConsecutivas = 0;
-    for (const auto& turma : turmas) {
-        for (const auto& disc : disciplinas) {
-            totalConsecutivas += contarAulasConsecutivas(turma.id, disc.id);
+    for (int t = 0; t < instancia->numTurmas(); t++) {
+        for (int d = 0; d < instancia->numDisciplinas(); d++) {
+            totalConsecutivas += contarAulasConsecutivas(t, d);
         }
     }
     std::cout << "  Aulas consecutivas: " << totalConsecutivas << std::endl;
@@ -837,23 +905,24 @@ void GeradorHorario::exportarJSON(const std::string& nomeArquivo) const {
     j["metadata"]["aulasAlocadas"] = stats.aulasAlocadas;
     j["metadata"]["taxaSucesso"] = (stats.totalAulas > 0) ? (stats.aulasAlocadas * 100.0 / stats.totalAulas) : 0.0;
     j["metadata"]["turmas"] = json::array();
-    for (const auto& t : turmas) j["metadata"]["turmas"].push_back(t.nome);
+    for (const auto& t : instancia->getTurmas()) j["metadata"]["turmas"].push_back(t.nome);
     j["metadata"]["dias"] = {"Segunda", "Terça", "Quarta", "Quinta", "Sexta"};
     j["metadata"]["horarios"] = {"7:30-8:15", "8:15-9:00", "9:00-9:45", "10:05-10:50", "10:50-11:35", "11:35-12:20"};
 
     // Aulas
     j["aulas"] = json::array();
-    for (size_t i = 0; i < gradeHoraria.size(); i++) {
-        const auto& aula = gradeHoraria[i];
+    const std::vector<Aula> grade = getGradeHoraria();
+    for (size_t i = 0; i < grade.size(); i++) {
+        const auto& aula = grade[i];
         json j_aula;
         j_aula["id"] = i + 1;
-        j_aula["turma"] = mapaNomesTurmas.at(aula.idTurma);
+        j_aula["turma"] = nomeTurma(aula.idTurma);
         j_aula["turmaId"] = aula.idTurma;
-        j_aula["disciplina"] = mapaNomesDisciplinas.at(aula.idDisciplina);
+        j_aula["disciplina"] = nomeDisciplina(aula.idDisciplina);
         j_aula["disciplinaId"] = aula.idDisciplina;
-        j_aula["professor"] = mapaNomesProfessores.at(aula.idProfessor);
+        j_aula["professor"] = nomeProfessor(aula.idProfessor);
         j_aula["professorId"] = aula.idProfessor;
-        j_aula["sala"] = mapaNomesSalas.at(aula.idSala);
+        j_aula["sala"] = nomeSala(aula.idSala);
         j_aula["salaId"] = aula.idSala;
         j_aula["dia"] = aula.slot.dia;
         j_aula["diaNome"] = getDiaNome(aula.slot.dia);
@@ -865,10 +934,10 @@ void GeradorHorario::exportarJSON(const std::string& nomeArquivo) const {
 
     // Estatísticas
     for (const auto& [idTurma, qtd] : stats.aulasPorTurma) {
-        j["estatisticas"]["aulasPorTurma"][mapaNomesTurmas.at(idTurma)] = qtd;
+        j["estatisticas"]["aulasPorTurma"][nomeTurma(idTurma)] = qtd;
     }
     for (const auto& [idProf, qtd] : stats.aulasPorProfessor) {
-        j["estatisticas"]["aulasPorProfessor"][mapaNomesProfessores.at(idProf)] = qtd;
+        j["estatisticas"]["aulasPorProfessor"][nomeProfessor(idProf)] = qtd;
     }
     for (int d = 0; d < 5; d++) {
         j["estatisticas"]["aulasPorDia"][getDiaNome(d)] = stats.aulasPorDia.count(d) ? stats.aulasPorDia.at(d) : 0;
@@ -919,11 +988,11 @@ void GeradorHorario::exportarCSV(const std::string& nomeArquivo) const {
     arquivo << "Turma,Disciplina,Professor,Sala,Dia,Horário\n";
 
     // Dados
-    for (const auto& aula : gradeHoraria) {
-        arquivo << mapaNomesTurmas.at(aula.idTurma) << ","
-                << mapaNomesDisciplinas.at(aula.idDisciplina) << ","
-                << mapaNomesProfessores.at(aula.idProfessor) << ","
-                << mapaNomesSalas.at(aula.idSala) << ","
+    for (const auto& aula : getGradeHoraria()) {
+        arquivo << nomeTurma(aula.idTurma) << ","
+                << nomeDisciplina(aula.idDisciplina) << ","
+                << nomeProfessor(aula.idProfessor) << ","
+                << nomeSala(aula.idSala) << ","
                 << getDiaNome(aula.slot.dia) << ","
                 << getHorarioInicio(aula.slot.hora) << "-" << getHorarioFim(aula.slot.hora) << "\n";
     }
@@ -938,8 +1007,9 @@ void GeradorHorario::imprimirHorario() {
     const std::vector<std::string> diasNomes = { "Segunda", "Terça", "Quarta", "Quinta", "Sexta" };
     const std::vector<std::string> horariosNomes = { "7:30-8:15", "8:15-9:00", "9:00-9:45",
                                                     "10:05-10:50", "10:50-11:35", "11:35-12:20" };
+    const std::vector<Aula> grade = getGradeHoraria();
 
-    for (const auto& t : turmas) {
+    for (const auto& t : instancia->getTurmas()) {
         std::cout << "\n" << std::string(80, '=') << std::endl;
         std::cout << "HORÁRIO: " << t.nome << std::endl;
         std::cout << std::string(80, '=') << std::endl;
@@ -955,10 +1025,10 @@ void GeradorHorario::imprimirHorario() {
             std::cout << std::setw(14) << horariosNomes[h];
             for (int d = 0; d < (int)diasNomes.size(); ++d) {
                 bool achou = false;
-                for (const auto& aula : gradeHoraria) {
+                for (const auto& aula : grade) {
                     if (aula.idTurma == t.id && aula.slot.dia == d && aula.slot.hora == h) {
-                        std::string nomeProf = mapaNomesProfessores.at(aula.idProfessor);
-                        std::string nomeDisc = mapaNomesDisciplinas.at(aula.idDisciplina);
+                        std::string nomeProf = nomeProfessor(aula.idProfessor);
+                        std::string nomeDisc = nomeDisciplina(aula.idDisciplina);
 
                         // Truncar nomes longos
                         if (nomeDisc.length() > 12) nomeDisc = nomeDisc.substr(0, 11) + ".";
@@ -979,7 +1049,7 @@ void GeradorHorario::imprimirHorario() {
         // Mini estatística por turma
         int totalAulasTurma = 0;
         std::map<int, int> aulasPorDisciplina;
-        for (const auto& aula : gradeHoraria) {
+        for (const auto& aula : grade) {
             if (aula.idTurma == t.id) {
                 totalAulasTurma++;
                 aulasPorDisciplina[aula.idDisciplina]++;
@@ -1,6 +1,9 @@
 #pragma once
 #include "Estruturas.h"
+#include "InstanciaCompilada.h"
+#include "Aleatorio.h"
 #include <vector>
+#include <array>
 #include <set>
 #include <tuple>
 #include <map>
@@ -42,6 +45,24 @@ struct ConfiguracaoGerador {
     bool evitarAulasExtremos = true;
     int maxTentativasPorRequisicao = 100;
     bool verboso = false;
+    uint64_t semente = 0; // 0 = não determinística
+};
+
+// Unidade de demanda: as requisições idênticas (mesmo professor, turma e
+// disciplina) traduzidas para os índices densos da InstanciaCompilada. Os
+// itens de uma unidade são intercambiáveis e alocados como uma contagem.
+// Numa disciplina geminada os itens são blocos de duas aulas seguidas no
+// mesmo dia, e a aula ímpar, se houver, fica numa unidade avulsa à parte
+struct RequisicaoCompilada {
+    int professor;
+    int turma;
+    int disciplina;
+    int sala; // -1 se a turma não tem sala associada
+    int grupo; // Par (turma, disciplina), índice em ocupacaoGrupo
+    int quantidade; // Itens da unidade
+    int tamanhoBloco; // Aulas por item: 2 = bloco geminado, 1 = aula avulsa
+
+    int aulas() const { return quantidade * tamanhoBloco; }
 };
 
 class GeradorHorario {
@@ -59,6 +80,13 @@ public:
         ConfiguracaoGerador config = ConfiguracaoGerador()
     );
 
+    // Construtor a partir de uma instância já compilada (compartilhável)
+    GeradorHorario(
+        std::shared_ptr<const InstanciaCompilada> instancia,
+        std::vector<RequisicaoAlocacao> reqs,
+        ConfiguracaoGerador config = ConfiguracaoGerador()
+    );
+
     // Métodos principais
     bool gerarHorario();
     void reset();
@@ -66,9 +94,10 @@ public:
     void mostrarEstatisticasGrade();
 
     // Métodos de acesso
-    std::vector<Aula> getGradeHoraria() const { return gradeHoraria; }
-    void setGradeHoraria(const std::vector<Aula>& novaGrade) { gradeHoraria = novaGrade; }
+    std::vector<Aula> getGradeHoraria() const;
+    void setGradeHoraria(const std::vector<Aula>& novaGrade);
     EstatisticasGrade obterEstatisticasDetalhadas() const;
+    std::shared_ptr<const InstanciaCompilada> getInstancia() const { return instancia; }
 
     // Exportação melhorada
     void exportarJSON(const std::string& nomeArquivo) const;
@@ -79,19 +108,26 @@ public:
     bool validarGradeCompleta() const;
     std::vector<std::string> obterProblemasGrade() const;
 
+    // Fluxo aleatório do embaralhamento dos grupos de criticidade
+    // (padrão: semente da configuração)
+    void setAleatorio(const Aleatorio& fluxo) { aleatorio = fluxo; }
+
     // Callbacks para progresso
     void setCallbackProgresso(std::function<void(int, int)> callback) {
         callbackProgresso = callback;
     }
 
 private:
+    // Micro-benchmarks dos métodos internos (Benchmark.cpp)
+    friend class AcessoBenchmark;
+
     // Dados de entrada
-    std::vector<Professor> professores;
-    std::vector<Disciplina> disciplinas;
-    std::vector<Turma> turmas;
-    std::vector<Sala> salas;
+    std::shared_ptr<const InstanciaCompilada> instancia;
     std::vector<RequisicaoAlocacao> requisicoes;
-    std::vector<Aula> gradeHoraria;
+    std::vector<RequisicaoCompilada> requisicoesCompiladas;
+    // Grade em alocação, na representação compacta (convertida para Aula
+    // apenas em getGradeHoraria, relatórios e exportação)
+    std::vector<AulaCompacta> gradeHoraria;
 
         // Funções auxiliares para exportação
     std::string obterDataHoraAtual() const;
@@ -102,33 +138,59 @@ private:
     // Configurações
     ConfiguracaoGerador configuracao;
 
-    // Mapas para tradução e consulta
-    std::map<int, std::string> mapaNomesProfessores;
-    std::map<int, std::string> mapaNomesDisciplinas;
-    std::map<int, std::string> mapaNomesTurmas;
-    std::map<int, std::string> mapaNomesSalas;
-    std::map<int, Disciplina> mapaDisciplinas;
-    std::map<int, int> turmaSalaMap;
+    // Ocupação da grade por entidade (índice denso -> máscara de slots ocupados),
+    // mantida a cada inserção e zerada no reset
+    std::vector<MascaraSlots> ocupacaoProfessor;
+    std::vector<MascaraSlots> ocupacaoTurma;
+    std::vector<MascaraSlots> ocupacaoSala;
+    // Slots ocupados por par (turma, disciplina) das requisições; o índice do
+    // par vem de grupoPorTurmaDisciplina[turma * numDisciplinas + disciplina]
+    std::vector<MascaraSlots> ocupacaoGrupo;
+    std::unordered_map<int, int> grupoPorTurmaDisciplina;
 
-    // Estruturas de controle
-    std::set<std::tuple<int, int, int>> disponibilidadeProfessores;
-    std::map<int, int> disponibilidadeTotalProfessores;
-
-    // Cache para otimização
-    mutable std::map<std::tuple<int, int, int>, bool> cacheDisponibilidade;
+    // Gerador aleatório do embaralhamento entre tentativas
+    Aleatorio aleatorio;
 
     // Callback para progresso
     std::function<void(int, int)> callbackProgresso;
 
+    // Estado da construção com propagação de restrições: domínio (slots
+    // livres, ou inícios de bloco livres numa unidade geminada) e itens
+    // restantes de cada unidade, e índices das unidades por professor, turma
+    // e sala para propagar cada alocação
+    struct EstadoPropagacao {
+        std::vector<MascaraSlots> dominio;
+        std::vector<int> restantes; // 0 = unidade já alocada
+        std::vector<std::vector<int>> porProfessor;
+        std::vector<std::vector<int>> porTurma;
+        std::vector<std::vector<int>> porSala;
+        // Unidades por folga (tamanho do domínio menos itens restantes);
+        // entradas obsoletas (folga reduzida ou unidade já alocada) são
+        // descartadas na retirada
+        std::array<std::vector<int>, NUM_SLOTS + 1> baldes;
+
+        int folga(int unidade) const {
+            return __builtin_popcount(dominio[unidade]) - restantes[unidade];
+        }
+    };
+
     // Métodos privados principais
-    StatusAlocacao tentarAlocarRequisicao(const RequisicaoAlocacao& req);
-    bool verificarDisponibilidade(int idTurma, int idProfessor, int idSala, Slot slot);
+    void compilarRequisicoes();
+    bool inicializarDominios(EstadoPropagacao& estado);
+    int selecionarMaisRestrita(EstadoPropagacao& estado);
+    int escolherSlot(const EstadoPropagacao& estado, int requisicao);
+    int propagarAlocacao(EstadoPropagacao& estado, int requisicao, MascaraSlots ocupados);
+    bool verificarDisponibilidade(const RequisicaoCompilada& req, Slot slot);
+    MascaraSlots obterSlotsLivres(const RequisicaoCompilada& req) const;
+    MascaraSlots obterDominio(const RequisicaoCompilada& req) const;
+    void registrarOcupacao(const RequisicaoCompilada& req, int slotId);
+    void reconstruirOcupacao();
+    AulaCompacta criarAula(const RequisicaoCompilada& req, const Slot& slot) const;
 
     // Métodos de análise e otimização
-    void analisarCargaDeTrabalho(const std::vector<RequisicaoAlocacao>& requisicoes);
-    float calcularCriticidade(int idProfessor, int aulasNecessarias);
-    std::vector<Slot> obterSlotsOrdenados(const RequisicaoAlocacao& req);
-    int calcularPontuacaoSlot(const RequisicaoAlocacao& req, const Slot& slot);
+    void analisarCargaDeTrabalho(const std::vector<int>& ordem);
+    float calcularCriticidade(int professor, int aulasNecessarias);
+    int calcularPontuacaoSlot(const RequisicaoCompilada& req, const Slot& slot);
 
     // Métodos de validação interna
     bool validarConsistenciaInterna() const;
@@ -137,10 +199,16 @@ private:
     bool verificarConflitosSala() const;
 
     // Métodos auxiliares
-    int contarJanelasHorario(int idProfessor) const;
-    int contarAulasConsecutivas(int idTurma, int idDisciplina) const;
+    int contarJanelasHorario(int professor) const;
+    int contarAulasConsecutivas(int turma, int disciplina) const;
     std::map<int, std::vector<int>> obterDistribuicaoSemanal(int idTurma) const;
 
+    // Nomes por ID original (para relatórios e exportação)
+    const std::string& nomeProfessor(int id) const;
+    const std::string& nomeDisciplina(int id) const;
+    const std::string& nomeTurma(int id) const;
+    const std::string& nomeSala(int id) const;
+
     // Logging
     void log(const std::string& mensagem, bool forcarExibicao = false) const;
     void logErro(const std::string& mensagem) const;
@@ -0,0 +1,295 @@
+#include "InstanciaCompilada.h"
+#include "Aleatorio.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+// ==============================================================================
+// GERADOR DE ESCOLAS SINTÉTICAS (EXECUTÁVEL NATIVO)
+// ==============================================================================
+//
+// Gera instâncias de qualquer tamanho no formato lido por carregarDadosJSON
+// (turmas, disciplinas, professores com disponibilidade, salas e associações
+// turma-sala), sempre com solução: primeiro é plantada uma grade válida e só
+// depois são derivados os professores e a disponibilidade.
+//
+//  1. Cada turma recebe `aulas` slots sorteados, divididos entre as suas
+//     `disciplinas` matérias.
+//  2. Cada bloco (turma, matéria) vai para o primeiro professor da mesma
+//     matéria e do mesmo turno que esteja livre em todos os slots do bloco e
+//     caiba na carga máxima (escassez * 30 aulas); se nenhum servir, um novo
+//     professor é criado. No formato de entrada um professor leciona uma
+//     única disciplina, então cada professor gera uma disciplina própria
+//     ("Matemática 3") com as turmas que recebeu.
+//  3. A disponibilidade de cada professor são os slots plantados mais cada
+//     um dos demais com probabilidade `densidade`.
+//
+// Uso: ./gerador_sintetico [--turmas N] [--aulas N] [--disciplinas N]
+//                          [--escassez F] [--densidade F] [--turnos M,T,N]
+//                          [--semente N] [--saida escola.json]
+//                          [--solucao plantada.json]
+
+struct ParametrosSintetico {
+    int numTurmas = 20;
+    int aulasPorTurma = 25;           // Aulas semanais de cada turma (até 30)
+    int disciplinasPorTurma = 8;      // Matérias de cada turma (até 12)
+    double escassez = 0.8;            // Carga máxima do professor / 30 slots
+    double densidade = 0.3;           // Probabilidade de um slot não plantado estar disponível
+    double fracaoTurnos[3] = {0.5, 0.4, 0.1}; // Manhã, tarde, noite
+    uint64_t semente = 1;
+};
+
+namespace {
+
+const char* const NOMES_MATERIAS[] = {
+    "Português", "Matemática", "História", "Geografia", "Ciências", "Inglês",
+    "Artes", "Educação Física", "Física", "Química", "Biologia", "Filosofia"
+};
+const int NUM_MATERIAS = 12;
+const char* const NOMES_TURNOS[] = {"manha", "tarde", "noite"};
+
+// Aula da grade plantada, com índices da geração
+struct AulaPlantada {
+    int turma;
+    int professor;
+    int slot;
+};
+
+// Professor derivado: matéria, turno, slots ocupados e turmas atendidas
+struct ProfessorSintetico {
+    int materia;
+    int turno;
+    MascaraSlots ocupacao = 0;
+    int carga = 0;
+    std::vector<std::pair<int, int>> turmas; // (turma, aulas)
+};
+
+// Turnos na proporção pedida (arredondamento pelo maior resto)
+std::vector<int> distribuirTurnos(const ParametrosSintetico& p) {
+    double soma = p.fracaoTurnos[0] + p.fracaoTurnos[1] + p.fracaoTurnos[2];
+    std::vector<int> turnos;
+    double acumulado = 0.0;
+    for (int turno = 0; turno < 3; turno++) {
+        acumulado += soma > 0 ? p.fracaoTurnos[turno] / soma : (turno == 0 ? 1.0 : 0.0);
+        int ate = turno == 2 ? p.numTurmas : static_cast<int>(acumulado * p.numTurmas + 0.5);
+        while (static_cast<int>(turnos.size()) < ate) {
+            turnos.push_back(turno);
+        }
+    }
+    return turnos;
+}
+
+json gerarEscola(const ParametrosSintetico& p, json& solucaoPlantada) {
+    Aleatorio gen(p.semente);
+
+    const int aulas = std::clamp(p.aulasPorTurma, 1, NUM_SLOTS);
+    const int materias = std::clamp(p.disciplinasPorTurma, 1, std::min(NUM_MATERIAS, aulas));
+    const int cargaMaxima = std::clamp(static_cast<int>(p.escassez * NUM_SLOTS + 0.5), 1, NUM_SLOTS);
+    std::vector<int> turnos = distribuirTurnos(p);
+
+    // 1. Grade de cada turma: slots sorteados divididos entre as matérias.
+    // blocos[turma][m] = máscara dos slots da matéria m na turma
+    std::vector<std::vector<MascaraSlots>> blocos(p.numTurmas, std::vector<MascaraSlots>(materias, 0));
+    for (int t = 0; t < p.numTurmas; t++) {
+        std::vector<int> slots(NUM_SLOTS);
+        std::iota(slots.begin(), slots.end(), 0);
+        std::shuffle(slots.begin(), slots.end(), gen);
+
+        // As matérias que recebem a sobra da divisão variam por turma
+        std::vector<int> ordem(materias);
+        std::iota(ordem.begin(), ordem.end(), 0);
+        std::shuffle(ordem.begin(), ordem.end(), gen);
+
+        int proximo = 0;
+        for (int i = 0; i < materias; i++) {
+            int quantidade = aulas / materias + (i < aulas % materias ? 1 : 0);
+            for (int k = 0; k < quantidade; k++) {
+                blocos[t][ordem[i]] |= InstanciaCompilada::bitSlot(slots[proximo++]);
+            }
+        }
+    }
+
+    // 2. Blocos (turma, matéria) em ordem aleatória para professores por first-fit
+    std::vector<std::pair<int, int>> pendentes;
+    for (int t = 0; t < p.numTurmas; t++) {
+        for (int m = 0; m < materias; m++) {
+            pendentes.push_back({t, m});
+        }
+    }
+    std::shuffle(pendentes.begin(), pendentes.end(), gen);
+
+    std::vector<ProfessorSintetico> professores;
+    std::vector<std::vector<std::vector<int>>> professoresPorGrupo(3, std::vector<std::vector<int>>(materias));
+    std::vector<AulaPlantada> grade;
+
+    for (const auto& [t, m] : pendentes) {
+        MascaraSlots bloco = blocos[t][m];
+        int carga = __builtin_popcount(bloco);
+
+        int escolhido = -1;
+        for (int candidato : professoresPorGrupo[turnos[t]][m]) {
+            const auto& prof = professores[candidato];
+            if (!(prof.ocupacao & bloco) && prof.carga + carga <= cargaMaxima) {
+                escolhido = candidato;
+                break;
+            }
+        }
+        if (escolhido < 0) {
+            escolhido = static_cast<int>(professores.size());
+            ProfessorSintetico novo;
+            novo.materia = m;
+            novo.turno = turnos[t];
+            professores.push_back(novo);
+            professoresPorGrupo[turnos[t]][m].push_back(escolhido);
+        }
+
+        auto& prof = professores[escolhido];
+        prof.ocupacao |= bloco;
+        prof.carga += carga;
+        prof.turmas.push_back({t, carga});
+        for (int slot = 0; slot < NUM_SLOTS; slot++) {
+            if (bloco & InstanciaCompilada::bitSlot(slot)) {
+                grade.push_back({t, escolhido, slot});
+            }
+        }
+    }
+
+    // 3. Saída no formato de carregarDadosJSON. IDs começam em 1; a turma t
+    // usa a sala t + 1 e o professor i ensina a disciplina i + 1
+    json escola;
+    escola["turmas"] = json::array();
+    escola["salas"] = json::array();
+    json turmaSala = json::object();
+    for (int t = 0; t < p.numTurmas; t++) {
+        escola["turmas"].push_back({
+            {"id", t + 1},
+            {"nome", "Turma " + std::to_string(t + 1)},
+            {"turno", NOMES_TURNOS[turnos[t]]}
+        });
+        escola["salas"].push_back({
+            {"id", t + 1},
+            {"nome", "Sala " + std::to_string(t + 1)},
+            {"tipo", "normal"},
+            {"compartilhada", false},
+            {"capacidade", 40}
+        });
+        turmaSala[std::to_string(t + 1)] = t + 1;
+    }
+    escola["associacoes"] = {{"turmaSala", turmaSala}};
+
+    escola["disciplinas"] = json::array();
+    escola["professores"] = json::array();
+    std::vector<int> numeroNaMateria(NUM_MATERIAS, 0);
+    for (size_t i = 0; i < professores.size(); i++) {
+        const auto& prof = professores[i];
+        int id = static_cast<int>(i) + 1;
+
+        json aulasPorTurma = json::object();
+        for (const auto& [t, carga] : prof.turmas) {
+            aulasPorTurma[std::to_string(t + 1)] = carga;
+        }
+        escola["disciplinas"].push_back({
+            {"id", id},
+            {"nome", std::string(NOMES_MATERIAS[prof.materia]) + " " +
+                     std::to_string(++numeroNaMateria[prof.materia])},
+            {"aulasPorTurma", aulasPorTurma}
+        });
+
+        json disponibilidade = json::array();
+        for (int slot = 0; slot < NUM_SLOTS; slot++) {
+            bool plantado = prof.ocupacao & InstanciaCompilada::bitSlot(slot);
+            if (plantado || gen.real() < p.densidade) {
+                disponibilidade.push_back({{"dia", slot / NUM_HORARIOS}, {"horario", slot % NUM_HORARIOS}});
+            }
+        }
+        escola["professores"].push_back({
+            {"id", id},
+            {"nome", "Professor " + std::to_string(id)},
+            {"idDisciplina", id},
+            {"disponibilidade", disponibilidade}
+        });
+    }
+
+    solucaoPlantada = json::array();
+    for (const auto& aula : grade) {
+        solucaoPlantada.push_back({
+            {"idTurma", aula.turma + 1},
+            {"idDisciplina", aula.professor + 1},
+            {"idProfessor", aula.professor + 1},
+            {"idSala", aula.turma + 1},
+            {"dia", aula.slot / NUM_HORARIOS},
+            {"horario", aula.slot % NUM_HORARIOS}
+        });
+    }
+
+    std::cout << "Turmas: " << p.numTurmas << " | Professores: " << professores.size()
+              << " | Aulas: " << grade.size() << " | Carga máxima: " << cargaMaxima << std::endl;
+    return escola;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ParametrosSintetico parametros;
+    std::string arquivoSaida = "escola_sintetica.json";
+    std::string arquivoSolucao;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argumento = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Argumento sem valor: " << argumento << std::endl;
+            return 1;
+        }
+        std::string valor = argv[++i];
+        if (argumento == "--turmas") {
+            parametros.numTurmas = std::max(std::stoi(valor), 1);
+        } else if (argumento == "--aulas") {
+            parametros.aulasPorTurma = std::stoi(valor);
+        } else if (argumento == "--disciplinas") {
+            parametros.disciplinasPorTurma = std::stoi(valor);
+        } else if (argumento == "--escassez") {
+            parametros.escassez = std::stod(valor);
+        } else if (argumento == "--densidade") {
+            parametros.densidade = std::stod(valor);
+        } else if (argumento == "--turnos") {
+            // Frações de manhã, tarde e noite separadas por vírgula
+            size_t inicio = 0;
+            for (int turno = 0; turno < 3; turno++) {
+                size_t fim = valor.find(',', inicio);
+                parametros.fracaoTurnos[turno] =
+                    inicio < valor.size() ? std::stod(valor.substr(inicio, fim - inicio)) : 0.0;
+                inicio = fim == std::string::npos ? valor.size() : fim + 1;
+            }
+        } else if (argumento == "--semente") {
+            parametros.semente = std::stoull(valor);
+        } else if (argumento == "--saida") {
+            arquivoSaida = valor;
+        } else if (argumento == "--solucao") {
+            arquivoSolucao = valor;
+        } else {
+            std::cerr << "Argumento desconhecido: " << argumento << std::endl;
+            return 1;
+        }
+    }
+
+    json solucaoPlantada;
+    json escola = gerarEscola(parametros, solucaoPlantada);
+
+    std::ofstream saida(arquivoSaida);
+    saida << escola.dump(2) << std::endl;
+    std::cout << "Escola exportada para: " << arquivoSaida << std::endl;
+
+    if (!arquivoSolucao.empty()) {
+        std::ofstream solucao(arquivoSolucao);
+        solucao << json{{"aulas", solucaoPlantada}}.dump(2) << std::endl;
+        std::cout << "Solução plantada exportada para: " << arquivoSolucao << std::endl;
+    }
+
+    return 0;
+}
@@ -1,6 +1,8 @@
 #include <emscripten/emscripten.h>
 #include <emscripten/bind.h>
 #include "GeradorHorario.h"
+#include "ConstrucaoParalela.h"
+#include "TemperaturaParalela.h"
 #include "SimulatedAnnealing.h"
 #include "json.hpp"
 #include <sstream>
@@ -57,6 +59,7 @@ std::string processarGradeHoraria(std::string dadosJSON, bool aplicarOtimizacao
             for (const auto& [turmaId, carga] : d["aulasPorTurma"].items()) {
                 disc.aulasPorTurma[std::stoi(turmaId)] = carga.get<int>();
             }
+            disc.requerAulasGeminadas = d.contains("requerAulasGeminadas") && d["requerAulasGeminadas"].get<bool>();
 
             disciplinas.push_back(disc);
         }
@@ -126,59 +129,73 @@ std::string processarGradeHoraria(std::string dadosJSON, bool aplicarOtimizacao
         reportProgress("Iniciando Fase 1: Geração inicial...", 20);
 
         // FASE 1: Executar gerador
+        // Semente opcional para resultados reproduzíveis (0 = não determinística)
+        uint64_t semente = entrada.contains("semente") ? entrada["semente"].get<uint64_t>() : 0;
+
+        // Prazo opcional em segundos para as duas fases (0 = sem prazo) e
+        // janela de convergência do SA em passos por réplica (0 = desligada)
+        double tempoLimite = entrada.contains("tempoLimite") ? entrada["tempoLimite"].get<double>() : 0.0;
+        int janelaConvergencia = entrada.contains("janelaConvergencia") ? entrada["janelaConvergencia"].get<int>() : 0;
+        Prazo prazo = tempoLimite > 0 ? Prazo::emSegundos(tempoLimite) : Prazo();
+
         ConfiguracaoGerador config;
         config.verboso = false;
+        config.semente = semente;
 
         GeradorHorario gerador(professores, disciplinas, turmas, salas, requisicoes,
                               disponibilidade, disponibilidadeTotalProf, turmaSalaMap, config);
 
-        // Tentar gerar grade inicial
-        bool sucessoFase1 = false;
-        std::vector<Aula> gradeInicial;
+        // Tentar gerar grade inicial (tentativas independentes, paralelas quando há threads)
+        ConfiguracaoConstrucao configConstrucao;
+        configConstrucao.maxTentativas = 10000;
+        configConstrucao.prazo = prazo;
 
-        for (int tentativa = 1; tentativa <= 10000; tentativa++) {
-            if (tentativa % 10 == 0) {
-                std::stringstream msg;
-                msg << "Fase 1: Tentativa " << tentativa << " de 100...";
-                reportProgress(msg.str().c_str(), 20 + (tentativa / 100.0 * 30));
-            }
+        ConstrucaoParalela construcao(gerador.getInstancia(), requisicoes, config, configConstrucao);
 
-            if (gerador.gerarHorario()) {
-                gradeInicial = gerador.getGradeHoraria();
+        // Verificar integridade
+        construcao.setValidacao([&disciplinas](const std::vector<Aula>& grade) {
+            std::map<std::pair<int, int>, int> aulasAlocadas;
+            std::map<std::pair<int, int>, int> aulasRequeridas;
 
-                // Verificar integridade
-                std::map<std::pair<int, int>, int> aulasAlocadas;
-                std::map<std::pair<int, int>, int> aulasRequeridas;
-
-                for (const auto& disc : disciplinas) {
-                    for (const auto& [idTurma, qtd] : disc.aulasPorTurma) {
-                        aulasRequeridas[{idTurma, disc.id}] = qtd;
-                    }
+            for (const auto& disc : disciplinas) {
+                for (const auto& [idTurma, qtd] : disc.aulasPorTurma) {
+                    aulasRequeridas[{idTurma, disc.id}] = qtd;
                 }
+            }
 
-                for (const auto& aula : gradeInicial) {
-                    aulasAlocadas[{aula.idTurma, aula.idDisciplina}]++;
-                }
+            for (const auto& aula : grade) {
+                aulasAlocadas[{aula.idTurma, aula.idDisciplina}]++;
+            }
 
-                bool valida = true;
-                for (const auto& [chave, req] : aulasRequeridas) {
-                    if (aulasAlocadas[chave] != req) {
-                        valida = false;
-                        break;
-                    }
+            for (const auto& [chave, req] : aulasRequeridas) {
+                if (aulasAlocadas[chave] != req) {
+                    return false;
                 }
+            }
+            return true;
+        });
 
-                if (valida) {
-                    sucessoFase1 = true;
-                    break;
-                }
+        construcao.setCallbackTentativa([](int tentativa) {
+            if (tentativa % 10 == 0) {
+                std::stringstream msg;
+                msg << "Fase 1: Tentativa " << tentativa << " de 100...";
+                reportProgress(msg.str().c_str(), 20 + (tentativa / 100.0 * 30));
             }
-            gerador.reset();
+        });
+
+        ResultadoConstrucao resultadoFase1 = construcao.executar();
+        bool sucessoFase1 = resultadoFase1.sucesso;
+        std::vector<Aula> gradeInicial;
+        if (sucessoFase1) {
+            gradeInicial = resultadoFase1.grades.front();
         }
 
         if (!sucessoFase1) {
             json erro;
-            erro["erro"] = "Não foi possível gerar uma grade inicial válida após 10000 tentativas";
+            erro["erro"] = resultadoFase1.prazoEsgotado
+                ? "Prazo esgotado sem uma grade inicial válida após " +
+                  std::to_string(resultadoFase1.tentativas) + " tentativas"
+                : "Não foi possível gerar uma grade inicial válida após 10000 tentativas";
             return erro.dump();
         }
 
@@ -191,46 +208,72 @@ std::string processarGradeHoraria(std::string dadosJSON, bool aplicarOtimizacao
         if (aplicarOtimizacao) {
             reportProgress("Iniciando Fase 2: Otimização com Simulated Annealing...", 55);
 
-            ConfiguracaoSA configSA;
-            configSA.numIteracoes = 50000; // Menos iterações para WebAssembly
-            configSA.temperaturaInicial = 100.0;
-            configSA.taxaResfriamento = 0.95;
-            configSA.verboso = false;
-
-            SimulatedAnnealing sa(
+            ConfiguracaoTemperaturaParalela configPT;
+            configPT.temperaturaMinima = 0.5;
+            configPT.temperaturaMaxima = 100.0;
+            configPT.numRodadas = 25; // Menos iterações para WebAssembly
+            configPT.passosPorRodada = 250;
+            configPT.configSA.semente = semente;
+            configPT.configSA.prazo = prazo;
+            configPT.configSA.janelaConvergencia = janelaConvergencia;
+            configPT.verboso = false;
+
+            TemperaturaParalela otimizador(
                 gradeInicial,
-                professores,
-                disciplinas,
-                turmas,
-                salas,
-                disponibilidade,
-                turmaSalaMap,
-                configSA
+                gerador.getInstancia(),
+                configPT
             );
 
             // Callback para progresso
-            sa.executarComCallback([](int iteracao, double temperatura, double custo) {
-                if (iteracao % 100 == 0) {
-                    std::stringstream msg;
-                    msg << "Fase 2: Otimizando... (iteração " << iteracao << ")";
-                    // Estimar progresso baseado em 5000 iterações
-                    int progresso = 55 + (iteracao * 40 / 5000);
-                    if (progresso > 95) progresso = 95;
-                    reportProgress(msg.str().c_str(), progresso);
-                }
+            otimizador.setCallbackProgresso([](int rodada, int totalRodadas, double melhorCusto) {
+                std::stringstream msg;
+                msg << "Fase 2: Otimizando... (rodada " << rodada << " de " << totalRodadas << ")";
+                int progresso = 55 + (rodada * 40 / totalRodadas);
+                reportProgress(msg.str().c_str(), progresso);
             });
 
-            gradeFinal = sa.getSolucaoFinal();
+            otimizador.executar();
+
+            gradeFinal = otimizador.getSolucaoFinal();
 
             // Coletar estatísticas
-            auto stats = sa.getEstatisticas();
+            auto stats = otimizador.getEstatisticas();
             estatisticasOtimizacao["custoInicial"] = stats.custoInicial;
             estatisticasOtimizacao["custoFinal"] = stats.custoFinal;
             estatisticasOtimizacao["melhoria"] = stats.getPercentualMelhoria();
-            estatisticasOtimizacao["iteracoes"] = configSA.numIteracoes;
+            estatisticasOtimizacao["iteracoes"] = stats.iteracoesExecutadas;
+            estatisticasOtimizacao["criterioParada"] = nomeCriterioParada(stats.criterioParada);
             estatisticasOtimizacao["movimentosAceitos"] = stats.movimentosAceitos;
             estatisticasOtimizacao["movimentosRejeitados"] = stats.movimentosRejeitados;
             estatisticasOtimizacao["taxaAceitacao"] = stats.getTaxaAceitacao();
+            estatisticasOtimizacao["replicas"] = otimizador.getNumReplicas();
+
+            estatisticasOtimizacao["degraus"] = json::array();
+            for (const auto& degrau : otimizador.getEstatisticasDegraus()) {
+                json d;
+                d["temperatura"] = degrau.temperatura;
+                d["taxaAceitacao"] = degrau.getTaxaAceitacao();
+                d["taxaTroca"] = degrau.getTaxaTroca();
+                estatisticasOtimizacao["degraus"].push_back(d);
+            }
+
+            // Telemetria por tipo de movimento (somada entre as réplicas)
+            estatisticasOtimizacao["movimentos"] = json::array();
+            for (int t = 0; t < NUM_TIPOS_MOVIMENTO; t++) {
+                const auto& m = stats.porMovimento[t];
+                json mov;
+                mov["tipo"] = nomeTipoMovimento(static_cast<TipoMovimento>(t));
+                mov["propostos"] = m.propostos;
+                mov["rejeitadosInviaveis"] = m.rejeitadosInviaveis;
+                mov["rejeitadosTabu"] = m.rejeitadosTabu;
+                mov["aceitos"] = m.aceitos;
+                mov["melhorias"] = m.melhorias;
+                mov["deltaMedio"] = m.getDeltaMedio();
+                mov["nsGeracao"] = m.nsGeracao;
+                mov["nsAvaliacao"] = m.nsAvaliacao;
+                mov["peso"] = stats.pesosMovimento[t];
+                estatisticasOtimizacao["movimentos"].push_back(mov);
+            }
             reportProgress("Fase 2 concluída! Grade otimizada.", 95);
         }
 
@@ -297,7 +340,7 @@ std::string processarGradeHoraria(std::string dadosJSON, bool aplicarOtimizacao
 
         // Adicionar estatísticas gerais
         resultado["estatisticas"]["totalAulas"] = gradeFinal.size();
-        resultado["estatisticas"]["fase1"]["tentativas"] = 1; // Simplificado
+        resultado["estatisticas"]["fase1"]["tentativas"] = resultadoFase1.tentativas;
         resultado["estatisticas"]["fase1"]["sucesso"] = true;
 
         reportProgress("Processamento concluído!", 100);
@@ -0,0 +1,104 @@
+#include "InstanciaCompilada.h"
+#include <bitset>
+#include <limits>
+#include <stdexcept>
+
+InstanciaCompilada::InstanciaCompilada(
+    const std::vector<Professor>& professores,
+    const std::vector<Disciplina>& disciplinas,
+    const std::vector<Turma>& turmas,
+    const std::vector<Sala>& salas,
+    const std::set<std::tuple<int, int, int>>& disponibilidade,
+    const std::map<int, int>& turmaSalaMap)
+    : professores(professores), disciplinas(disciplinas),
+      turmas(turmas), salas(salas)
+{
+    // Os índices precisam caber nos campos de 16 bits da AulaCompacta
+    const size_t limite = std::numeric_limits<int16_t>::max();
+    if (professores.size() > limite || disciplinas.size() > limite ||
+        turmas.size() > limite || salas.size() > limite) {
+        throw std::invalid_argument("Instância grande demais: no máximo " +
+                                    std::to_string(limite) + " entidades de cada tipo");
+    }
+
+    // Remapeamento de IDs para índices contíguos
+    for (size_t i = 0; i < professores.size(); i++) {
+        indicePorIdProfessor[professores[i].id] = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < disciplinas.size(); i++) {
+        indicePorIdDisciplina[disciplinas[i].id] = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < turmas.size(); i++) {
+        indicePorIdTurma[turmas[i].id] = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < salas.size(); i++) {
+        indicePorIdSala[salas[i].id] = static_cast<int>(i);
+    }
+
+    // Disponibilidade dos professores como máscara de slots
+    mascaraDisponibilidade.assign(professores.size(), 0);
+    for (const auto& [idProf, dia, hora] : disponibilidade) {
+        int p = indiceProfessor(idProf);
+        if (p < 0 || dia < 0 || dia >= NUM_DIAS || hora < 0 || hora >= NUM_HORARIOS) continue;
+        mascaraDisponibilidade[p] |= bitSlot(slotId(dia, hora));
+    }
+
+    totalDisponibilidade.resize(professores.size());
+    for (size_t p = 0; p < professores.size(); p++) {
+        totalDisponibilidade[p] = static_cast<int>(std::bitset<NUM_SLOTS>(mascaraDisponibilidade[p]).count());
+    }
+
+    // Turmas: sala associada e turno
+    salaPorTurma.assign(turmas.size(), -1);
+    turnoPorTurma.resize(turmas.size());
+    for (size_t t = 0; t < turmas.size(); t++) {
+        turnoPorTurma[t] = turmas[t].turno;
+        auto it = turmaSalaMap.find(turmas[t].id);
+        if (it != turmaSalaMap.end()) {
+            salaPorTurma[t] = indiceSala(it->second);
+        }
+    }
+
+    // Disciplinas: carga total e horários preferidos
+    cargaTotal.resize(disciplinas.size());
+    mascaraHorariosPreferidos.assign(disciplinas.size(), 0);
+    for (size_t d = 0; d < disciplinas.size(); d++) {
+        cargaTotal[d] = disciplinas[d].getCargaHorariaTotal();
+        for (int hora : disciplinas[d].horariosPreferidos) {
+            if (hora >= 0 && hora < NUM_HORARIOS) {
+                mascaraHorariosPreferidos[d] |= static_cast<uint8_t>(1u << hora);
+            }
+        }
+    }
+
+    // Salas
+    compartilhada.resize(salas.size());
+    for (size_t s = 0; s < salas.size(); s++) {
+        compartilhada[s] = salas[s].compartilhada ? 1 : 0;
+    }
+}
+
+AulaCompacta InstanciaCompilada::compactarAula(const Aula& aula) const {
+    int p = indiceProfessor(aula.idProfessor);
+    int t = indiceTurma(aula.idTurma);
+    int d = indiceDisciplina(aula.idDisciplina);
+
+    if (p < 0 || t < 0 || d < 0) {
+        throw std::invalid_argument("Aula com professor, turma ou disciplina inexistente: " +
+                                    aula.toString());
+    }
+
+    AulaCompacta compacta;
+    compacta.professor = static_cast<int16_t>(p);
+    compacta.turma = static_cast<int16_t>(t);
+    compacta.disciplina = static_cast<int16_t>(d);
+    compacta.sala = static_cast<int16_t>(indiceSala(aula.idSala));
+    compacta.setSlot(aula.slot);
+    return compacta;
+}
+
+Aula InstanciaCompilada::expandirAula(const AulaCompacta& aula) const {
+    int idSala = aula.sala >= 0 ? salas[aula.sala].id : 0;
+    return Aula(professores[aula.professor].id, disciplinas[aula.disciplina].id,
+                turmas[aula.turma].id, idSala, aula.getSlot());
+}
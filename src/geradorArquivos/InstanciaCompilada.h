@@ -0,0 +1,163 @@
+#pragma once
+#include "Estruturas.h"
+#include <vector>
+#include <set>
+#include <map>
+#include <tuple>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+
+// ==============================================================================
+// DIMENSÕES DA GRADE
+// ==============================================================================
+
+constexpr int NUM_DIAS = 5;
+constexpr int NUM_HORARIOS = 6;
+constexpr int NUM_SLOTS = NUM_DIAS * NUM_HORARIOS;
+
+// Conjunto de slots da semana: o bit (dia * 6 + hora) ligado indica o slot
+using MascaraSlots = uint32_t;
+
+constexpr MascaraSlots MASCARA_SEMANA = (1u << NUM_SLOTS) - 1;
+// Horas de um dia, a deslocar de dia * NUM_HORARIOS
+constexpr MascaraSlots MASCARA_DIA = (1u << NUM_HORARIOS) - 1;
+// Slots em que um bloco de duas aulas seguidas (geminadas) pode começar:
+// todas as horas menos a última de cada dia
+constexpr MascaraSlots MASCARA_INICIO_GEMINADA = [] {
+    MascaraSlots mascara = 0;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        mascara |= (MASCARA_DIA >> 1) << (dia * NUM_HORARIOS);
+    }
+    return mascara;
+}();
+
+// Inícios de bloco geminado com os dois slots na máscara
+constexpr MascaraSlots iniciosGeminada(MascaraSlots livres) {
+    return livres & (livres >> 1) & MASCARA_INICIO_GEMINADA;
+}
+// Slots cobertos pelos blocos geminados que começam nos inícios dados
+constexpr MascaraSlots slotsGeminada(MascaraSlots inicios) {
+    return inicios | (inicios << 1);
+}
+
+// ==============================================================================
+// AULA COMPACTA
+// ==============================================================================
+
+// Aula na representação usada pelos laços internos dos solvers: só os índices
+// densos e o slot empacotado (dia * 6 + hora), em 10 bytes trivialmente
+// copiáveis. A Aula completa, com IDs e metadados, fica na fronteira.
+struct AulaCompacta {
+    int16_t professor;
+    int16_t turma;
+    int16_t disciplina;
+    int16_t sala;   // -1 se a sala não está cadastrada
+    uint8_t slot;   // dia * NUM_HORARIOS + hora
+
+    int dia() const { return slot / NUM_HORARIOS; }
+    int hora() const { return slot % NUM_HORARIOS; }
+    Slot getSlot() const { return Slot(dia(), hora()); }
+    void setSlot(const Slot& s) { slot = static_cast<uint8_t>(s.dia * NUM_HORARIOS + s.hora); }
+};
+
+static_assert(std::is_trivially_copyable<AulaCompacta>::value,
+              "AulaCompacta deve ser trivialmente copiável");
+
+// ==============================================================================
+// INSTÂNCIA COMPILADA
+// ==============================================================================
+
+// Versão "compilada" dos dados de entrada, compartilhada pelo GeradorHorario e
+// pelo SimulatedAnnealing. Os IDs de professores, turmas, disciplinas e salas
+// são remapeados para índices contíguos (0..n-1) e todas as consultas feitas
+// nos laços internos viram acesso direto a vetores. Os IDs originais só são
+// usados na fronteira (importação/exportação).
+class InstanciaCompilada {
+public:
+    InstanciaCompilada(
+        const std::vector<Professor>& professores,
+        const std::vector<Disciplina>& disciplinas,
+        const std::vector<Turma>& turmas,
+        const std::vector<Sala>& salas,
+        const std::set<std::tuple<int, int, int>>& disponibilidade,
+        const std::map<int, int>& turmaSalaMap
+    );
+
+    // Tamanhos
+    int numProfessores() const { return static_cast<int>(professores.size()); }
+    int numDisciplinas() const { return static_cast<int>(disciplinas.size()); }
+    int numTurmas() const { return static_cast<int>(turmas.size()); }
+    int numSalas() const { return static_cast<int>(salas.size()); }
+
+    // Remapeamento ID -> índice denso (-1 se o ID não existe)
+    int indiceProfessor(int id) const { return buscarIndice(indicePorIdProfessor, id); }
+    int indiceDisciplina(int id) const { return buscarIndice(indicePorIdDisciplina, id); }
+    int indiceTurma(int id) const { return buscarIndice(indicePorIdTurma, id); }
+    int indiceSala(int id) const { return buscarIndice(indicePorIdSala, id); }
+
+    // Entidades originais por índice denso
+    const Professor& professor(int indice) const { return professores[indice]; }
+    const Disciplina& disciplina(int indice) const { return disciplinas[indice]; }
+    const Turma& turma(int indice) const { return turmas[indice]; }
+    const Sala& sala(int indice) const { return salas[indice]; }
+
+    const std::vector<Professor>& getProfessores() const { return professores; }
+    const std::vector<Disciplina>& getDisciplinas() const { return disciplinas; }
+    const std::vector<Turma>& getTurmas() const { return turmas; }
+    const std::vector<Sala>& getSalas() const { return salas; }
+
+    // Tabelas por professor
+    MascaraSlots disponibilidadeProfessor(int p) const { return mascaraDisponibilidade[p]; }
+    bool professorDisponivel(int p, int slotId) const { return (mascaraDisponibilidade[p] >> slotId) & 1u; }
+    int disponibilidadeTotal(int p) const { return totalDisponibilidade[p]; }
+
+    // Tabelas por turma
+    int salaDaTurma(int t) const { return salaPorTurma[t]; }  // índice denso, -1 se sem sala
+    Turno turnoTurma(int t) const { return turnoPorTurma[t]; }
+
+    // Tabelas por disciplina
+    int cargaTotalDisciplina(int d) const { return cargaTotal[d]; }
+    bool temHorariosPreferidos(int d) const { return !disciplinas[d].horariosPreferidos.empty(); }
+    bool disciplinaGeminada(int d) const { return disciplinas[d].requerAulasGeminadas; }
+    // Máscara de 6 bits com os horários preferidos (bit h = hora h)
+    uint8_t horariosPreferidos(int d) const { return mascaraHorariosPreferidos[d]; }
+
+    // Tabelas por sala
+    bool salaCompartilhada(int s) const { return compartilhada[s] != 0; }
+
+    // Conversão entre Aula (IDs) e AulaCompacta (índices densos).
+    // compactarAula lança std::invalid_argument se professor, turma ou
+    // disciplina não existem; uma sala desconhecida vira -1.
+    AulaCompacta compactarAula(const Aula& aula) const;
+    Aula expandirAula(const AulaCompacta& aula) const;
+
+    // Conversões entre Slot e índice de bit
+    static int slotId(int dia, int hora) { return dia * NUM_HORARIOS + hora; }
+    static MascaraSlots bitSlot(int slotId) { return 1u << slotId; }
+
+private:
+    std::vector<Professor> professores;
+    std::vector<Disciplina> disciplinas;
+    std::vector<Turma> turmas;
+    std::vector<Sala> salas;
+
+    std::unordered_map<int, int> indicePorIdProfessor;
+    std::unordered_map<int, int> indicePorIdDisciplina;
+    std::unordered_map<int, int> indicePorIdTurma;
+    std::unordered_map<int, int> indicePorIdSala;
+
+    std::vector<MascaraSlots> mascaraDisponibilidade;
+    std::vector<int> totalDisponibilidade;
+    std::vector<int> salaPorTurma;
+    std::vector<Turno> turnoPorTurma;
+    std::vector<int> cargaTotal;
+    std::vector<uint8_t> mascaraHorariosPreferidos;
+    std::vector<uint8_t> compartilhada;
+
+    static int buscarIndice(const std::unordered_map<int, int>& mapa, int id) {
+        auto it = mapa.find(id);
+        return it != mapa.end() ? it->second : -1;
+    }
+};
@@ -0,0 +1,331 @@
+#include "KernelsPenalidade.h"
+#include <array>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Bônus de consecutivas de cada máscara de 6 horas de um dia
+const std::array<int, 1 << NUM_HORARIOS> TABELA_CONSECUTIVAS = [] {
+    std::array<int, 1 << NUM_HORARIOS> tabela{};
+    for (int mascara = 0; mascara < (1 << NUM_HORARIOS); mascara++) {
+        int bonus = 0;
+        int sequencia = 0;
+        for (int hora = 0; hora <= NUM_HORARIOS; hora++) {
+            if (hora < NUM_HORARIOS && ((mascara >> hora) & 1)) {
+                sequencia++;
+            } else {
+                if (sequencia >= 2) {
+                    bonus += sequencia * sequencia * 5;
+                }
+                sequencia = 0;
+            }
+        }
+        tabela[mascara] = bonus;
+    }
+    return tabela;
+}();
+
+// Soma de 2 * j² das janelas de j >= 3 horários de cada máscara de um dia
+const std::array<int, 1 << NUM_HORARIOS> TABELA_JANELAS_LONGAS = [] {
+    std::array<int, 1 << NUM_HORARIOS> tabela{};
+    for (int mascara = 0; mascara < (1 << NUM_HORARIOS); mascara++) {
+        int penalidade = 0;
+        int anterior = -1;
+        for (int hora = 0; hora < NUM_HORARIOS; hora++) {
+            if (!((mascara >> hora) & 1)) continue;
+            int janela = anterior >= 0 ? hora - anterior - 1 : 0;
+            if (janela >= 3) {
+                penalidade += janela * janela * 2;
+            }
+            anterior = hora;
+        }
+        tabela[mascara] = penalidade;
+    }
+    return tabela;
+}();
+
+double somarFaixas(const double acumulado[LINHAS_POR_BLOCO]) {
+    return (acumulado[0] + acumulado[1]) + (acumulado[2] + acumulado[3]);
+}
+
+#if defined(__AVX2__)
+
+// Penalidade 1 das 4 linhas do bloco (mesma sequência de penalidadeDistribuicaoLinha)
+inline __m256d blocoDistribuicao(const MatrizDias& matriz, int bloco) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d cinco = _mm256_set1_pd(5.0);
+    const __m256d sete = _mm256_set1_pd(7.0);
+    const __m256d dez = _mm256_set1_pd(10.0);
+
+    __m256d c[NUM_DIAS];
+    __m256d total = zero;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        c[dia] = _mm256_loadu_pd(&matriz.contagem[dia * matriz.largura + bloco]);
+        total = _mm256_add_pd(total, c[dia]);
+    }
+
+    __m256d media = _mm256_div_pd(total, cinco);
+    __m256d variancia = zero;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        __m256d desvio = _mm256_sub_pd(c[dia], media);
+        variancia = _mm256_add_pd(variancia, _mm256_mul_pd(desvio, desvio));
+    }
+
+    __m256d penalidade = _mm256_sqrt_pd(_mm256_div_pd(variancia, cinco));
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        __m256d excesso = _mm256_max_pd(_mm256_sub_pd(c[dia], sete), zero);
+        penalidade = _mm256_add_pd(penalidade, _mm256_mul_pd(excesso, dez));
+        __m256d vazio = _mm256_cmp_pd(c[dia], zero, _CMP_EQ_OQ);
+        penalidade = _mm256_add_pd(penalidade, _mm256_and_pd(vazio, cinco));
+    }
+
+    return _mm256_and_pd(_mm256_cmp_pd(total, zero, _CMP_GT_OQ), penalidade);
+}
+
+inline __m256d blocoDesvio(const MatrizDias& matriz, int bloco) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d sinal = _mm256_set1_pd(-0.0);
+
+    __m256d c[NUM_DIAS];
+    __m256d total = zero;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        c[dia] = _mm256_loadu_pd(&matriz.contagem[dia * matriz.largura + bloco]);
+        total = _mm256_add_pd(total, c[dia]);
+    }
+
+    __m256d media = _mm256_div_pd(total, _mm256_set1_pd(5.0));
+    __m256d desvio = zero;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        desvio = _mm256_add_pd(desvio, _mm256_andnot_pd(sinal, _mm256_sub_pd(c[dia], media)));
+    }
+
+    return _mm256_and_pd(_mm256_cmp_pd(total, zero, _CMP_GT_OQ), desvio);
+}
+
+#elif defined(__SSE2__)
+
+// Metade (2 linhas) de um bloco, a partir da linha `inicio`
+inline __m128d metadeDistribuicao(const MatrizDias& matriz, int inicio) {
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d cinco = _mm_set1_pd(5.0);
+    const __m128d sete = _mm_set1_pd(7.0);
+    const __m128d dez = _mm_set1_pd(10.0);
+
+    __m128d c[NUM_DIAS];
+    __m128d total = zero;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        c[dia] = _mm_loadu_pd(&matriz.contagem[dia * matriz.largura + inicio]);
+        total = _mm_add_pd(total, c[dia]);
+    }
+
+    __m128d media = _mm_div_pd(total, cinco);
+    __m128d variancia = zero;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        __m128d desvio = _mm_sub_pd(c[dia], media);
+        variancia = _mm_add_pd(variancia, _mm_mul_pd(desvio, desvio));
+    }
+
+    __m128d penalidade = _mm_sqrt_pd(_mm_div_pd(variancia, cinco));
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        __m128d excesso = _mm_max_pd(_mm_sub_pd(c[dia], sete), zero);
+        penalidade = _mm_add_pd(penalidade, _mm_mul_pd(excesso, dez));
+        penalidade = _mm_add_pd(penalidade, _mm_and_pd(_mm_cmpeq_pd(c[dia], zero), cinco));
+    }
+
+    return _mm_and_pd(_mm_cmpgt_pd(total, zero), penalidade);
+}
+
+inline __m128d metadeDesvio(const MatrizDias& matriz, int inicio) {
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d sinal = _mm_set1_pd(-0.0);
+
+    __m128d c[NUM_DIAS];
+    __m128d total = zero;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        c[dia] = _mm_loadu_pd(&matriz.contagem[dia * matriz.largura + inicio]);
+        total = _mm_add_pd(total, c[dia]);
+    }
+
+    __m128d media = _mm_div_pd(total, _mm_set1_pd(5.0));
+    __m128d desvio = zero;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        desvio = _mm_add_pd(desvio, _mm_andnot_pd(sinal, _mm_sub_pd(c[dia], media)));
+    }
+
+    return _mm_and_pd(_mm_cmpgt_pd(total, zero), desvio);
+}
+
+#endif
+
+} // namespace
+
+MatrizDias::MatrizDias(int linhas)
+    : linhas(linhas),
+      largura((linhas + LINHAS_POR_BLOCO - 1) / LINHAS_POR_BLOCO * LINHAS_POR_BLOCO),
+      contagem(static_cast<size_t>(largura) * NUM_DIAS, 0.0) {}
+
+double penalidadeDistribuicaoLinha(const int aulasPorDia[NUM_DIAS]) {
+    int totalAulas = 0;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        totalAulas += aulasPorDia[dia];
+    }
+    if (totalAulas == 0) return 0.0;
+
+    double mediaIdeal = totalAulas / 5.0;
+    double variancia = 0.0;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        double desvio = aulasPorDia[dia] - mediaIdeal;
+        variancia += desvio * desvio;
+    }
+
+    double penalidade = std::sqrt(variancia / 5.0);
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        if (aulasPorDia[dia] > 7) { // Mais de 7 aulas em um dia é excessivo
+            penalidade += (aulasPorDia[dia] - 7) * 10;
+        }
+        if (aulasPorDia[dia] == 0) { // Dia sem aulas também não é ideal
+            penalidade += 5;
+        }
+    }
+
+    return penalidade;
+}
+
+double somaPenalidadeDistribuicao(const MatrizDias& matriz) {
+    alignas(32) double acumulado[LINHAS_POR_BLOCO] = {0.0, 0.0, 0.0, 0.0};
+
+#if defined(__AVX2__)
+    __m256d soma = _mm256_setzero_pd();
+    for (int bloco = 0; bloco < matriz.largura; bloco += LINHAS_POR_BLOCO) {
+        soma = _mm256_add_pd(soma, blocoDistribuicao(matriz, bloco));
+    }
+    _mm256_store_pd(acumulado, soma);
+#elif defined(__SSE2__)
+    __m128d somaBaixa = _mm_setzero_pd();
+    __m128d somaAlta = _mm_setzero_pd();
+    for (int bloco = 0; bloco < matriz.largura; bloco += LINHAS_POR_BLOCO) {
+        somaBaixa = _mm_add_pd(somaBaixa, metadeDistribuicao(matriz, bloco));
+        somaAlta = _mm_add_pd(somaAlta, metadeDistribuicao(matriz, bloco + 2));
+    }
+    _mm_store_pd(acumulado, somaBaixa);
+    _mm_store_pd(acumulado + 2, somaAlta);
+#else
+    for (int bloco = 0; bloco < matriz.largura; bloco += LINHAS_POR_BLOCO) {
+        for (int faixa = 0; faixa < LINHAS_POR_BLOCO; faixa++) {
+            int aulasPorDia[NUM_DIAS];
+            for (int dia = 0; dia < NUM_DIAS; dia++) {
+                aulasPorDia[dia] = static_cast<int>(matriz.em(bloco + faixa, dia));
+            }
+            acumulado[faixa] += penalidadeDistribuicaoLinha(aulasPorDia);
+        }
+    }
+#endif
+
+    return somarFaixas(acumulado);
+}
+
+double somaDesvioDistribuicao(const MatrizDias& matriz) {
+    alignas(32) double acumulado[LINHAS_POR_BLOCO] = {0.0, 0.0, 0.0, 0.0};
+
+#if defined(__AVX2__)
+    __m256d soma = _mm256_setzero_pd();
+    for (int bloco = 0; bloco < matriz.largura; bloco += LINHAS_POR_BLOCO) {
+        soma = _mm256_add_pd(soma, blocoDesvio(matriz, bloco));
+    }
+    _mm256_store_pd(acumulado, soma);
+#elif defined(__SSE2__)
+    __m128d somaBaixa = _mm_setzero_pd();
+    __m128d somaAlta = _mm_setzero_pd();
+    for (int bloco = 0; bloco < matriz.largura; bloco += LINHAS_POR_BLOCO) {
+        somaBaixa = _mm_add_pd(somaBaixa, metadeDesvio(matriz, bloco));
+        somaAlta = _mm_add_pd(somaAlta, metadeDesvio(matriz, bloco + 2));
+    }
+    _mm_store_pd(acumulado, somaBaixa);
+    _mm_store_pd(acumulado + 2, somaAlta);
+#else
+    for (int bloco = 0; bloco < matriz.largura; bloco += LINHAS_POR_BLOCO) {
+        for (int faixa = 0; faixa < LINHAS_POR_BLOCO; faixa++) {
+            double total = 0.0;
+            for (int dia = 0; dia < NUM_DIAS; dia++) {
+                total += matriz.em(bloco + faixa, dia);
+            }
+            if (total == 0.0) continue;
+
+            double media = total / 5.0;
+            double desvio = 0.0;
+            for (int dia = 0; dia < NUM_DIAS; dia++) {
+                desvio += std::abs(matriz.em(bloco + faixa, dia) - media);
+            }
+            acumulado[faixa] += desvio;
+        }
+    }
+#endif
+
+    return somarFaixas(acumulado);
+}
+
+int bonusConsecutivasDia(MascaraSlots mascara, int dia) {
+    return TABELA_CONSECUTIVAS[(mascara >> (dia * NUM_HORARIOS)) & MASCARA_DIA];
+}
+
+int bonusConsecutivas(MascaraSlots mascara) {
+    int bonus = 0;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        bonus += bonusConsecutivasDia(mascara, dia);
+    }
+    return bonus;
+}
+
+int paresConsecutivos(MascaraSlots mascara) {
+    return __builtin_popcount(iniciosGeminada(mascara));
+}
+
+int blocosGeminados(MascaraSlots mascara) {
+    // O bloco de início mais cedo é sempre parte de um empacotamento máximo
+    int blocos = 0;
+    for (MascaraSlots inicios = iniciosGeminada(mascara); inicios; inicios = iniciosGeminada(mascara)) {
+        mascara &= ~slotsGeminada(inicios & -inicios);
+        blocos++;
+    }
+    return blocos;
+}
+
+int janelasDia(MascaraSlots mascara, int dia) {
+    MascaraSlots horas = (mascara >> (dia * NUM_HORARIOS)) & MASCARA_DIA;
+    if (horas == 0) return 0;
+    int extensao = (31 - __builtin_clz(horas)) - __builtin_ctz(horas) + 1;
+    return extensao - __builtin_popcount(horas);
+}
+
+int totalJanelas(MascaraSlots mascara) {
+    int total = 0;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        total += janelasDia(mascara, dia);
+    }
+    return total;
+}
+
+double penalidadeJanelas(MascaraSlots mascara) {
+    int total = totalJanelas(mascara);
+
+    double penalidade = 0.0;
+    if (total <= 2) {
+        penalidade += total * 5;
+    } else if (total <= 5) {
+        penalidade += 10 + (total - 2) * 10;
+    } else {
+        penalidade += 40 + (total - 5) * 20;
+    }
+
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        penalidade += TABELA_JANELAS_LONGAS[(mascara >> (dia * NUM_HORARIOS)) & MASCARA_DIA];
+    }
+
+    return penalidade;
+}
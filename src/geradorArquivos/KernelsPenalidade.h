@@ -0,0 +1,72 @@
+#pragma once
+#include "InstanciaCompilada.h"
+#include <vector>
+#include <cstdint>
+
+// ==============================================================================
+// NÚCLEOS DAS PENALIDADES SOBRE MATRIZES DENSAS
+// ==============================================================================
+//
+// O custo completo é montado em uma passada linear sobre a solução:
+//  - MatrizDias: contagem de aulas por (dia, linha), com as linhas (turmas)
+//    contíguas em cada dia. A distribuição (penalidade 1) vira uma redução
+//    sobre blocos de 4 linhas, com AVX2 ou SSE2 nas compilações nativas e
+//    um laço escalar nas demais (WebAssembly).
+//  - Máscaras de slots por grupo (turma, disciplina): as horas de cada dia
+//    ficam em 6 bits, e o bônus de consecutivas (penalidade 2) sai de uma
+//    tabela indexada pela máscara do dia.
+//  - Máscaras de slots por professor: as janelas de um dia são a extensão
+//    entre o primeiro e o último bit do dia menos o número de aulas.
+//
+// As três implementações da redução fazem as mesmas operações na mesma ordem
+// (acumuladores por faixa de 4 linhas), então o resultado é idêntico bit a bit
+// entre elas e igual, linha a linha, ao de penalidadeDistribuicaoLinha.
+
+constexpr int LINHAS_POR_BLOCO = 4;
+
+// Contagens dia-major: contagem[dia * largura + linha], largura múltipla de
+// LINHAS_POR_BLOCO e linhas de preenchimento zeradas (não contribuem)
+struct MatrizDias {
+    int linhas = 0;
+    int largura = 0;
+    std::vector<double> contagem;
+
+    explicit MatrizDias(int linhas);
+
+    void adicionar(int linha, int dia) { contagem[dia * largura + linha] += 1.0; }
+    double em(int linha, int dia) const { return contagem[dia * largura + linha]; }
+};
+
+// Penalidade 1 de uma linha (turma): desvio padrão das aulas por dia em
+// relação à média, 10 por aula acima de 7 num dia e 5 por dia vazio.
+// Zero se a linha não tem aulas
+double penalidadeDistribuicaoLinha(const int aulasPorDia[NUM_DIAS]);
+
+// Soma de penalidadeDistribuicaoLinha sobre todas as linhas
+double somaPenalidadeDistribuicao(const MatrizDias& matriz);
+
+// Soma, sobre as linhas com aulas, dos desvios absolutos de cada dia em
+// relação à média da linha
+double somaDesvioDistribuicao(const MatrizDias& matriz);
+
+// Bônus de consecutivas de uma máscara de slots de uma mesma disciplina numa
+// turma: 5 * L² por sequência de L >= 2 horas seguidas no mesmo dia
+int bonusConsecutivas(MascaraSlots mascara);
+int bonusConsecutivasDia(MascaraSlots mascara, int dia);
+
+// Pares de horas seguidas no mesmo dia presentes na máscara
+int paresConsecutivos(MascaraSlots mascara);
+
+// Máximo de blocos geminados disjuntos (duas horas seguidas no mesmo dia)
+// na máscara: cada sequência de L horas rende L / 2
+int blocosGeminados(MascaraSlots mascara);
+
+// Janelas (horários vagos entre a primeira e a última aula) de um dia da
+// máscara: extensão do primeiro ao último bit menos a contagem de bits
+int janelasDia(MascaraSlots mascara, int dia);
+int totalJanelas(MascaraSlots mascara);
+
+// Penalidade 3 de um professor: progressiva no total de janelas
+// (5, 10 e 20 por janela a partir de 0, 3 e 6) mais 2 * j² por janela de
+// j >= 3 horários
+double penalidadeJanelas(MascaraSlots mascara);
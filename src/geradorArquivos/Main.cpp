@@ -1,279 +1,11 @@
 #include "GeradorHorario.h"
 #include "SimulatedAnnealing.h"
+#include "ConstrucaoParalela.h"
+#include "TemperaturaParalela.h"
+#include "ModeloIlhas.h"
+#include "DadosEntrada.h"
 #include <map>
-#include <fstream>
 #include <chrono>
-#include "json.hpp"
-
-using json = nlohmann::json;
-
-// Função para criar o cenário de exemplo com base nos seus dados
-void setupDadosExemplo(
-    std::vector<Professor>& profs, std::vector<Disciplina>& discs,
-    std::vector<Turma>& turmas, std::vector<Sala>& salas,
-    std::vector<RequisicaoAlocacao>& reqs,
-    std::set<std::tuple<int, int, int>>& disponibilidade,
-    std::map<int, int>& turmaSalaMap) {
-
-    // --- Mapeamento de Strings para IDs ---
-    std::map<std::string, int> mapaIdDias = { {"Segunda", 0}, {"Terça", 1}, {"Quarta", 2}, {"Quinta", 3}, {"Sexta", 4} };
-    std::map<std::string, int> mapaIdHorarios = { {"7:30-8:15", 0}, {"8:15-9:00", 1}, {"9:00-9:45", 2},
-                                                  {"10:05-10:50", 3}, {"10:50-11:35", 4}, {"11:35-12:20", 5} };
-
-    std::map<std::string, int> mapaIdTurmas;
-    std::map<std::string, int> mapaIdDisciplinas;
-    std::map<std::string, int> mapaIdProfessores;
-
-    // --- Dados Brutos (como você forneceu) ---
-    const std::vector<std::string> turmasNomes = { "6º Ano", "7º Ano", "8º Ano", "9º Ano" };
-
-    // --- Processamento ---
-
-    int idCounter = 1;
-
-    // 1. Processar Turmas
-    for (const auto& nome : turmasNomes) {
-        turmas.push_back({ idCounter, nome });
-        mapaIdTurmas[nome] = idCounter++;
-    }
-
-    // 2. Processar Disciplinas
-    using CargaHorariaMap = std::map<std::string, int>;
-    std::map<std::string, CargaHorariaMap> disciplinasData = {
-        {"Ling. Port.", {{"6º Ano", 5}, {"7º Ano", 5}, {"8º Ano", 5}, {"9º Ano", 5}}},
-        {"Prod. Texto", {{"6º Ano", 2}, {"7º Ano", 2}, {"8º Ano", 2}, {"9º Ano", 2}}},
-        {"História", {{"6º Ano", 3}, {"7º Ano", 3}, {"8º Ano", 3}, {"9º Ano", 3}}},
-        {"Geografia", {{"6º Ano", 3}, {"7º Ano", 3}, {"8º Ano", 3}, {"9º Ano", 3}}},
-        {"Matemática", {{"6º Ano", 6}, {"7º Ano", 6}, {"8º Ano", 6}, {"9º Ano", 6}}},
-        {"Ciências", {{"6º Ano", 3}, {"7º Ano", 3}, {"8º Ano", 3}, {"9º Ano", 3}}},
-        {"Artes", {{"6º Ano", 1}, {"7º Ano", 1}, {"8º Ano", 1}, {"9º Ano", 1}}},
-        {"Educ. Física", {{"6º Ano", 1}, {"7º Ano", 1}, {"8º Ano", 1}, {"9º Ano", 1}}},
-        {"Musíca", {{"6º Ano", 1}, {"7º Ano", 1}, {"8º Ano", 1}, {"9º Ano", 1}}},
-        {"Educ. Socioemocional", {{"6º Ano", 1}, {"7º Ano", 1}, {"8º Ano", 1}, {"9º Ano", 1}}},
-        {"Inglês", {{"6º Ano", 2}, {"7º Ano", 2}, {"8º Ano", 2}, {"9º Ano", 2}}},
-        {"Robótica", {{"6º Ano", 1}, {"7º Ano", 1}, {"8º Ano", 1}, {"9º Ano", 1}}},
-        {"Espanhol", {{"6º Ano", 1}, {"7º Ano", 1}, {"8º Ano", 1}, {"9º Ano", 1}}}
-    };
-
-    idCounter = 101;
-    for (const auto& pair : disciplinasData) {
-        Disciplina novaDisc;
-        novaDisc.id = idCounter;
-        novaDisc.nome = pair.first;
-        for (const auto& cargaPair : pair.second) {
-            novaDisc.aulasPorTurma[mapaIdTurmas[cargaPair.first]] = cargaPair.second;
-        }
-        discs.push_back(novaDisc);
-        mapaIdDisciplinas[novaDisc.nome] = idCounter++;
-    }
-
-    // 3. Processar Professores e Disponibilidade
-    struct ProfData { std::string nome; std::vector<std::string> disciplinas; std::vector<std::pair<std::string, std::string>> disp; };
-    std::vector<ProfData> professoresData = {
-        {"Adilson", {"História"}, {{"Quarta", "7:30-8:15"}, {"Quarta", "8:15-9:00"}, {"Quarta", "9:00-9:45"}, {"Quarta", "10:05-10:50"},{"Quarta", "10:50-11:35"},{"Quarta", "11:35-12:20"}, {"Sexta", "7:30-8:15"}, {"Sexta", "8:15-9:00"}, {"Sexta", "9:00-9:45"}, {"Sexta", "10:05-10:50"},{"Sexta", "10:50-11:35"},{"Sexta", "11:35-12:20"}}},
-        {"Alexandra", {"Artes"}, {{"Segunda", "7:30-8:15"}, {"Segunda", "8:15-9:00"}, {"Segunda", "9:00-9:45"}, {"Segunda", "10:05-10:50"}}},
-        {"Ana Rosa", {"Geografia"}, {{"Segunda", "7:30-8:15"}, {"Segunda", "8:15-9:00"}, {"Segunda", "9:00-9:45"}, {"Segunda", "10:05-10:50"},{"Segunda", "10:50-11:35"},{"Segunda", "11:35-12:20"}, {"Terça", "7:30-8:15"}, {"Terça", "8:15-9:00"}, {"Terça", "9:00-9:45"}, {"Terça", "10:05-10:50"},{"Terça", "10:50-11:35"},{"Terça", "11:35-12:20"}, {"Quarta", "7:30-8:15"}, {"Quarta", "8:15-9:00"}, {"Quarta", "9:00-9:45"}, {"Quarta", "10:05-10:50"},{"Quarta", "10:50-11:35"},{"Quarta", "11:35-12:20"}, {"Quinta", "7:30-8:15"}, {"Quinta", "8:15-9:00"}, {"Quinta", "9:00-9:45"}, {"Quinta", "10:05-10:50"},{"Quinta", "10:50-11:35"},{"Quinta", "11:35-12:20"}}},
-        {"Bianca", {"Espanhol"}, {{"Segunda", "10:50-11:35"},{"Segunda", "11:35-12:20"}, {"Quinta", "10:50-11:35"},{"Quinta", "11:35-12:20"}}},
-        {"Denise", {"Inglês"},{{"Segunda", "9:00-9:45"}, {"Segunda", "10:05-10:50"},{"Segunda", "10:50-11:35"},{"Segunda", "11:35-12:20"}, {"Quarta", "9:00-9:45"}, {"Quarta", "10:05-10:50"},{"Quarta", "10:50-11:35"},{"Quarta", "11:35-12:20"}}},
-        {"Camila R.", {"Educ. Socioemocional"}, { {"Terça", "9:00-9:45"}, {"Terça", "10:05-10:50"},{"Terça", "10:50-11:35"},{"Terça", "11:35-12:20"}}},
-        {"Wanderlei", {"Matemática"}, {{"Segunda", "7:30-8:15"}, {"Segunda", "8:15-9:00"}, {"Segunda", "9:00-9:45"}, {"Segunda", "10:05-10:50"},{"Segunda", "10:50-11:35"},{"Segunda", "11:35-12:20"}, {"Terça", "7:30-8:15"}, {"Terça", "8:15-9:00"}, {"Terça", "9:00-9:45"}, {"Terça", "10:05-10:50"},{"Terça", "10:50-11:35"},{"Terça", "11:35-12:20"}, {"Quarta", "7:30-8:15"}, {"Quarta", "8:15-9:00"}, {"Quarta", "9:00-9:45"}, {"Quarta", "10:05-10:50"},{"Quarta", "10:50-11:35"},{"Quarta", "11:35-12:20"}, {"Quinta", "7:30-8:15"}, {"Quinta", "8:15-9:00"}, {"Quinta", "9:00-9:45"}, {"Quinta", "10:05-10:50"},{"Quinta", "10:50-11:35"},{"Quinta", "11:35-12:20"} ,{"Sexta", "7:30-8:15"}, {"Sexta", "8:15-9:00"}, {"Sexta", "9:00-9:45"}, {"Sexta", "10:05-10:50"},{"Sexta", "10:50-11:35"},{"Sexta", "11:35-12:20"}}},
-        {"Elizangela", {"Prod. Texto"}, {{"Quinta", "7:30-8:15"}, {"Quinta", "8:15-9:00"}, {"Quinta", "9:00-9:45"}, {"Quinta", "10:05-10:50"},{"Quinta", "10:50-11:35"},{"Quinta", "11:35-12:20"} ,{"Sexta", "7:30-8:15"}, {"Sexta", "8:15-9:00"}, {"Sexta", "9:00-9:45"}, {"Sexta", "10:05-10:50"},{"Sexta", "10:50-11:35"},{"Sexta", "11:35-12:20"}}},
-        {"Jéssica", {"Ciências"}, {{"Segunda", "7:30-8:15"}, {"Segunda", "8:15-9:00"}, {"Segunda", "9:00-9:45"}, {"Segunda", "10:05-10:50"},{"Segunda", "10:50-11:35"},{"Segunda", "11:35-12:20"}, {"Terça", "7:30-8:15"}, {"Terça", "8:15-9:00"}, {"Terça", "9:00-9:45"}, {"Terça", "10:05-10:50"},{"Terça", "10:50-11:35"},{"Terça", "11:35-12:20"}, {"Quarta", "7:30-8:15"}, {"Quarta", "8:15-9:00"}, {"Quarta", "9:00-9:45"}, {"Quarta", "10:05-10:50"},{"Quarta", "10:50-11:35"},{"Quarta", "11:35-12:20"}, {"Quinta", "7:30-8:15"}, {"Quinta", "8:15-9:00"}, {"Quinta", "9:00-9:45"}, {"Quinta", "10:05-10:50"},{"Quinta", "10:50-11:35"},{"Quinta", "11:35-12:20"} ,{"Sexta", "7:30-8:15"}, {"Sexta", "8:15-9:00"}, {"Sexta", "9:00-9:45"}, {"Sexta", "10:05-10:50"},{"Sexta", "10:50-11:35"},{"Sexta", "11:35-12:20"}}},
-        {"Kátia", {"Musíca"}, {{"Terça", "11:35-12:20"}, {"Sexta", "10:05-10:50"}, {"Sexta", "10:50-11:35"}, {"Sexta", "11:35-12:20"}}},
-        {"Neto", {"Educ. Física"}, {{"Terça", "10:50-11:35"}, {"Terça", "11:35-12:20"}, {"Quinta", "10:50-11:35"}, {"Quinta", "11:35-12:20"}}},
-        {"Ronaldo", {"Robótica"}, {{"Segunda", "7:30-8:15"}, {"Segunda", "8:15-9:00"}, {"Segunda", "9:00-9:45"}, {"Segunda", "10:05-10:50"},{"Segunda", "10:50-11:35"},{"Segunda", "11:35-12:20"}, {"Terça", "7:30-8:15"}, {"Terça", "8:15-9:00"}, {"Terça", "9:00-9:45"}, {"Terça", "10:05-10:50"},{"Terça", "10:50-11:35"},{"Terça", "11:35-12:20"}, {"Quarta", "7:30-8:15"}, {"Quarta", "8:15-9:00"}, {"Quarta", "9:00-9:45"}, {"Quarta", "10:05-10:50"},{"Quarta", "10:50-11:35"},{"Quarta", "11:35-12:20"}, {"Quinta", "7:30-8:15"}, {"Quinta", "8:15-9:00"}, {"Quinta", "9:00-9:45"}, {"Quinta", "10:05-10:50"},{"Quinta", "10:50-11:35"},{"Quinta", "11:35-12:20"} ,{"Sexta", "7:30-8:15"}, {"Sexta", "8:15-9:00"}, {"Sexta", "9:00-9:45"}, {"Sexta", "10:05-10:50"},{"Sexta", "10:50-11:35"},{"Sexta", "11:35-12:20"}}},
-        {"Selma", {"Ling. Port."}, {{"Segunda", "7:30-8:15"}, {"Segunda", "8:15-9:00"}, {"Segunda", "9:00-9:45"}, {"Segunda", "10:05-10:50"},{"Segunda", "10:50-11:35"},{"Segunda", "11:35-12:20"}, {"Terça", "7:30-8:15"}, {"Terça", "8:15-9:00"}, {"Terça", "9:00-9:45"}, {"Terça", "10:05-10:50"},{"Terça", "10:50-11:35"},{"Terça", "11:35-12:20"}, {"Quarta", "7:30-8:15"}, {"Quarta", "8:15-9:00"}, {"Quarta", "9:00-9:45"}, {"Quarta", "10:05-10:50"},{"Quarta", "10:50-11:35"},{"Quarta", "11:35-12:20"}, {"Quinta", "7:30-8:15"}, {"Quinta", "8:15-9:00"}, {"Quinta", "9:00-9:45"}, {"Quinta", "10:05-10:50"},{"Quinta", "10:50-11:35"},{"Quinta", "11:35-12:20"} ,{"Sexta", "7:30-8:15"}, {"Sexta", "8:15-9:00"}, {"Sexta", "9:00-9:45"}, {"Sexta", "10:05-10:50"},{"Sexta", "10:50-11:35"},{"Sexta", "11:35-12:20"}}}
-    };
-
-    idCounter = 201;
-    for (const auto& pData : professoresData) {
-        int profId = idCounter++;
-        profs.push_back({ profId, pData.nome });
-        mapaIdProfessores[pData.nome] = profId;
-        for (const auto& dispPair : pData.disp) {
-            disponibilidade.insert({ profId, mapaIdDias[dispPair.first], mapaIdHorarios[dispPair.second] });
-        }
-    }
-
-    // 4. Adicionar Salas
-    salas = { {501, "Sala 6º Ano", false}, {502, "Sala 7º Ano", false},
-              {503, "Sala 8º Ano", false}, {504, "Sala 9º Ano", false},
-              {505, "Quadra", true}, {506, "Lab", true} };
-
-    // Associar cada turma à sua sala específica
-    turmaSalaMap[mapaIdTurmas["6º Ano"]] = 501;
-    turmaSalaMap[mapaIdTurmas["7º Ano"]] = 502;
-    turmaSalaMap[mapaIdTurmas["8º Ano"]] = 503;
-    turmaSalaMap[mapaIdTurmas["9º Ano"]] = 504;
-
-    // 5. Gerar Requisições
-    for (const auto& discPair : disciplinasData) {
-        std::string nomeDisciplina = discPair.first;
-        int idDisciplina = mapaIdDisciplinas[nomeDisciplina];
-
-        // Encontrar o professor para esta disciplina
-        int idProfessor = -1;
-        for (const auto& profData : professoresData) {
-            if (!profData.disciplinas.empty() && profData.disciplinas[0] == nomeDisciplina) {
-                idProfessor = mapaIdProfessores[profData.nome];
-                break;
-            }
-        }
-
-        if (idProfessor == -1) {
-            std::cerr << "ERRO: Nao foi encontrado professor para a disciplina " << nomeDisciplina << std::endl;
-            continue;
-        }
-
-        // Criar requisições para cada turma
-        for (const auto& turmaPair : discPair.second) {
-            int idTurma = mapaIdTurmas[turmaPair.first];
-            int aulasNecessarias = turmaPair.second;
-
-            // Cria uma requisição para CADA AULA necessária
-            for (int i = 0; i < aulasNecessarias; ++i) {
-                reqs.push_back({ idTurma, idDisciplina, idProfessor });
-            }
-        }
-    }
-
-    // Mostra resumo dos dados carregados
-    std::cout << "\n=== DADOS CARREGADOS ===" << std::endl;
-    std::cout << "Turmas: " << turmas.size() << std::endl;
-    std::cout << "Disciplinas: " << discs.size() << std::endl;
-    std::cout << "Professores: " << profs.size() << std::endl;
-    std::cout << "Salas: " << salas.size() << std::endl;
-    std::cout << "Total de aulas a alocar: " << reqs.size() << std::endl;
-}
-
-void carregarDadosJSON(const std::string& arquivo,
-    std::vector<Professor>& profs,
-    std::vector<Disciplina>& discs,
-    std::vector<Turma>& turmas,
-    std::vector<Sala>& salas,
-    std::vector<RequisicaoAlocacao>& reqs,
-    std::set<std::tuple<int, int, int>>& disponibilidade,
-    std::map<int, int>& turmaSalaMap,
-    std::map<int, int>& disponibilidadeTotalProf) {
-
-    std::ifstream file(arquivo);
-    if (!file.is_open()) {
-        std::cerr << "Erro ao abrir arquivo: " << arquivo << std::endl;
-        return;
-    }
-
-    json j;
-    file >> j;
-
-    std::cout << "\n=== CARREGANDO DADOS DO ARQUIVO JSON ===" << std::endl;
-
-    // Carregar turmas
-    for (const auto& t : j["turmas"]) {
-        Turma turma;
-        turma.id = t["id"].get<int>();  // Conversão explícita
-        turma.nome = t["nome"].get<std::string>();  // Conversão explícita
-
-        std::string turnoStr = t["turno"].get<std::string>();  // Conversão explícita
-        if (turnoStr == "manha") turma.turno = Turno::MANHA;
-        else if (turnoStr == "tarde") turma.turno = Turno::TARDE;
-        else if (turnoStr == "noite") turma.turno = Turno::NOITE;
-
-        turmas.push_back(turma);
-    }
-
-    // Carregar disciplinas
-    for (const auto& d : j["disciplinas"]) {
-        Disciplina disc;
-        disc.id = d["id"].get<int>();  // Conversão explícita
-        disc.nome = d["nome"].get<std::string>();  // Conversão explícita
-
-        for (const auto& [turmaId, carga] : d["aulasPorTurma"].items()) {
-            disc.aulasPorTurma[std::stoi(turmaId)] = carga.get<int>();  // Conversão explícita
-        }
-
-        discs.push_back(disc);
-    }
-
-    // Carregar professores e disponibilidade
-    for (const auto& p : j["professores"]) {
-        Professor prof;
-        prof.id = p["id"].get<int>();  // Conversão explícita
-        prof.nome = p["nome"].get<std::string>();  // Conversão explícita
-
-        // CORREÇÃO PRINCIPAL: Conversão explícita para int
-        int disciplinaId = p["idDisciplina"].get<int>();
-        prof.disciplinasHabilitadas.insert(disciplinaId);
-
-        profs.push_back(prof);
-
-        // Inicializar contador de disponibilidade
-        disponibilidadeTotalProf[prof.id] = 0;
-
-        // Carregar disponibilidade
-        for (const auto& disp : p["disponibilidade"]) {
-            int dia = disp["dia"].get<int>();  // Conversão explícita
-            int horario = disp["horario"].get<int>();  // Conversão explícita
-            disponibilidade.insert({prof.id, dia, horario});
-            disponibilidadeTotalProf[prof.id]++;
-        }
-    }
-
-    // Carregar salas
-    for (const auto& s : j["salas"]) {
-        Sala sala;
-        sala.id = s["id"].get<int>();  // Conversão explícita
-        sala.nome = s["nome"].get<std::string>();  // Conversão explícita
-        sala.compartilhada = s["compartilhada"].get<bool>();  // Conversão explícita
-        sala.capacidade = s.contains("capacidade") ? s["capacidade"].get<int>() : 30;
-
-        std::string tipoStr = s["tipo"].get<std::string>();  // Conversão explícita
-        if (tipoStr == "laboratorio") sala.tipo = TipoSala::LABORATORIO;
-        else if (tipoStr == "quadra") sala.tipo = TipoSala::QUADRA;
-        else if (tipoStr == "biblioteca") sala.tipo = TipoSala::BIBLIOTECA;
-        else sala.tipo = TipoSala::NORMAL;
-
-        salas.push_back(sala);
-    }
-
-    // Carregar associações turma-sala
-    if (j.contains("associacoes") && j["associacoes"].contains("turmaSala")) {
-        for (const auto& [turmaId, salaId] : j["associacoes"]["turmaSala"].items()) {
-            turmaSalaMap[std::stoi(turmaId)] = salaId.get<int>();  // Conversão explícita
-        }
-    }
-
-    // Gerar requisições
-    std::cout << "\n=== GERANDO REQUISICOES ===" << std::endl;
-    for (const auto& disc : discs) {
-        // Encontrar professor para esta disciplina
-        int idProfessor = -1;
-        for (const auto& prof : profs) {
-            if (prof.disciplinasHabilitadas.count(disc.id) > 0) {
-                idProfessor = prof.id;
-                break;
-            }
-        }
-
-        if (idProfessor != -1) {
-            for (const auto& [idTurma, qtdAulas] : disc.aulasPorTurma) {
-                std::cout << "  Disciplina " << disc.nome << " para turma " << idTurma
-                          << ": " << qtdAulas << " aulas" << std::endl;
-                for (int i = 0; i < qtdAulas; i++) {
-                    reqs.push_back({idTurma, disc.id, idProfessor});
-                }
-            }
-        } else {
-            std::cerr << "  AVISO: Disciplina " << disc.nome << " sem professor!" << std::endl;
-        }
-    }
-
-    std::cout << "\n=== DADOS CARREGADOS COM SUCESSO ===" << std::endl;
-    std::cout << "Turmas: " << turmas.size() << std::endl;
-    std::cout << "Disciplinas: " << discs.size() << std::endl;
-    std::cout << "Professores: " << profs.size() << std::endl;
-    std::cout << "Salas: " << salas.size() << std::endl;
-    std::cout << "Total de aulas a alocar: " << reqs.size() << std::endl;
-}
 
 int main(int argc, char* argv[]) {
     std::vector<Professor> professores;
@@ -285,18 +17,39 @@ int main(int argc, char* argv[]) {
     std::map<int, int> turmaSalaMap;
     std::map<int, int> disponibilidadeTotalProf;
 
+    // Argumentos: [arquivo.json] [--ilhas] [--semente N] [--tempo S] [--convergencia N]
+    std::string arquivoDados;
+    bool usarIlhas = false;
+    uint64_t semente = 0; // 0 = não determinística
+    double tempoLimite = 0.0; // Segundos para as duas fases; 0 = sem prazo
+    int janelaConvergencia = 0; // Iterações do SA sem novo melhor custo; 0 = desligado
+    for (int i = 1; i < argc; i++) {
+        std::string argumento = argv[i];
+        if (argumento == "--ilhas") {
+            usarIlhas = true;
+        } else if (argumento == "--semente" && i + 1 < argc) {
+            semente = std::stoull(argv[++i]);
+        } else if (argumento == "--tempo" && i + 1 < argc) {
+            tempoLimite = std::stod(argv[++i]);
+        } else if (argumento == "--convergencia" && i + 1 < argc) {
+            janelaConvergencia = std::stoi(argv[++i]);
+        } else {
+            arquivoDados = argumento;
+        }
+    }
+
     // Verificar se foi passado um arquivo JSON como argumento
-    if (argc > 1) {
+    if (!arquivoDados.empty()) {
         std::cout << "=== MODO: CARREGAR DE ARQUIVO JSON ===" << std::endl;
-        std::cout << "Arquivo: " << argv[1] << std::endl;
+        std::cout << "Arquivo: " << arquivoDados << std::endl;
 
-        carregarDadosJSON(argv[1], professores, disciplinas, turmas,
+        carregarDadosJSON(arquivoDados, professores, disciplinas, turmas,
                          salas, requisicoes, disponibilidade, turmaSalaMap,
                          disponibilidadeTotalProf);
     } else {
         std::cout << "=== MODO: DADOS DE EXEMPLO ===" << std::endl;
         std::cout << "Para usar dados de um arquivo JSON, execute:" << std::endl;
-        std::cout << "  " << argv[0] << " <arquivo.json>" << std::endl;
+        std::cout << "  " << argv[0] << " <arquivo.json> [--ilhas] [--semente N] [--tempo S] [--convergencia N]" << std::endl;
         std::cout << std::endl;
 
         setupDadosExemplo(professores, disciplinas, turmas, salas,
@@ -314,85 +67,85 @@ int main(int argc, char* argv[]) {
     // FASE 1: Construção Inicial
     ConfiguracaoGerador config;
     config.verboso = true;
+    config.semente = semente;
 
     GeradorHorario gerador(professores, disciplinas, turmas, salas, requisicoes,
                           disponibilidade, disponibilidadeTotalProf, turmaSalaMap, config);
 
     const int MAX_TENTATIVAS = 100000;
-    bool sucesso = false;
-    int tentativasRealizadas = 0;
 
-    auto start = std::chrono::high_resolution_clock::now();
+    // VERIFICAÇÃO EXTERNA: carga alocada por (turma, disciplina) igual à requerida
+    auto verificarGrade = [&](const std::vector<Aula>& gradeResultante) {
+        std::map<std::pair<int, int>, int> aulasAlocadasPorTurmaDisciplina;
+        std::map<std::pair<int, int>, int> aulasRequeridasPorTurmaDisciplina;
 
-    for (int tentativa = 1; tentativa <= MAX_TENTATIVAS; ++tentativa) {
-        tentativasRealizadas = tentativa;
-        std::cout << "\n================== TENTATIVA NUMERO " << tentativa << " ==================" << std::endl;
+        for (const auto& disc : disciplinas) {
+            for (const auto& [idTurma, qtdAulas] : disc.aulasPorTurma) {
+                aulasRequeridasPorTurmaDisciplina[{idTurma, disc.id}] = qtdAulas;
+            }
+        }
 
-        if (gerador.gerarHorario()) {
-            std::cout << "\nVerificando a integridade da grade gerada..." << std::endl;
-            std::vector<Aula> gradeResultante = gerador.getGradeHoraria();
+        for (const auto& aula : gradeResultante) {
+            aulasAlocadasPorTurmaDisciplina[{aula.idTurma, aula.idDisciplina}]++;
+        }
 
-            // VERIFICAÇÃO EXTERNA
-            std::map<std::pair<int, int>, int> aulasAlocadasPorTurmaDisciplina;
-            std::map<std::pair<int, int>, int> aulasRequeridasPorTurmaDisciplina;
+        bool gradeValida = true;
+        for (const auto& [chave, aulasRequeridas] : aulasRequeridasPorTurmaDisciplina) {
+            int idTurma = chave.first;
+            int idDisciplina = chave.second;
+            int aulasAlocadas = aulasAlocadasPorTurmaDisciplina[chave];
+
+            if (aulasRequeridas != aulasAlocadas) {
+                gradeValida = false;
+                std::string nomeTurma = "???";
+                std::string nomeDisciplina = "???";
+
+                for (const auto& t : turmas) {
+                    if (t.id == idTurma) {
+                        nomeTurma = t.nome;
+                        break;
+                    }
+                }
 
-            for (const auto& disc : disciplinas) {
-                for (const auto& [idTurma, qtdAulas] : disc.aulasPorTurma) {
-                    aulasRequeridasPorTurmaDisciplina[{idTurma, disc.id}] = qtdAulas;
+                for (const auto& d : disciplinas) {
+                    if (d.id == idDisciplina) {
+                        nomeDisciplina = d.nome;
+                        break;
+                    }
                 }
-            }
 
-            for (const auto& aula : gradeResultante) {
-                aulasAlocadasPorTurmaDisciplina[{aula.idTurma, aula.idDisciplina}]++;
+                std::cout << "!!! FALHA NA VERIFICACAO: "
+                          << "Disciplina '" << nomeDisciplina << "' para Turma '" << nomeTurma
+                          << "' | Requerido: " << aulasRequeridas << " Alocado: " << aulasAlocadas << std::endl;
             }
+        }
 
-            bool gradeValida = true;
-            for (const auto& [chave, aulasRequeridas] : aulasRequeridasPorTurmaDisciplina) {
-                int idTurma = chave.first;
-                int idDisciplina = chave.second;
-                int aulasAlocadas = aulasAlocadasPorTurmaDisciplina[chave];
-
-                if (aulasRequeridas != aulasAlocadas) {
-                    gradeValida = false;
-                    std::string nomeTurma = "???";
-                    std::string nomeDisciplina = "???";
-
-                    for (const auto& t : turmas) {
-                        if (t.id == idTurma) {
-                            nomeTurma = t.nome;
-                            break;
-                        }
-                    }
+        return gradeValida;
+    };
 
-                    for (const auto& d : disciplinas) {
-                        if (d.id == idDisciplina) {
-                            nomeDisciplina = d.nome;
-                            break;
-                        }
-                    }
+    // Tentativas independentes em paralelo; a primeira grade completa encerra as demais
+    // O prazo começa na Fase 1 e é compartilhado com a Fase 2
+    Prazo prazo = tempoLimite > 0 ? Prazo::emSegundos(tempoLimite) : Prazo();
 
-                    std::cout << "!!! FALHA NA VERIFICACAO: "
-                              << "Disciplina '" << nomeDisciplina << "' para Turma '" << nomeTurma
-                              << "' | Requerido: " << aulasRequeridas << " Alocado: " << aulasAlocadas << std::endl;
-                }
-            }
+    ConfiguracaoConstrucao configConstrucao;
+    configConstrucao.maxTentativas = MAX_TENTATIVAS;
+    configConstrucao.prazo = prazo;
 
-            if (gradeValida) {
-                sucesso = true;
-                break;
-            } else {
-                std::cout << "--- ESTADO RESETADO, TENTANDO NOVAMENTE ---\n" << std::endl;
-                gerador.reset();
-            }
+    ConstrucaoParalela construcao(gerador.getInstancia(), requisicoes, config, configConstrucao);
+    construcao.setValidacao(verificarGrade);
 
-        } else {
-            std::cout << "--- ESTADO RESETADO, TENTANDO NOVAMENTE ---\n" << std::endl;
-            gerador.reset();
-        }
-    }
+    std::cout << "\n=== FASE 1: CONSTRUCAO COM " << construcao.getNumThreads()
+              << " THREAD(S) ===" << std::endl;
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    ResultadoConstrucao resultadoConstrucao = construcao.executar();
+    bool sucesso = resultadoConstrucao.sucesso;
+    int tentativasRealizadas = resultadoConstrucao.tentativas;
+    auto duration = std::chrono::milliseconds(static_cast<long long>(resultadoConstrucao.tempoMs));
+    double restanteFase1 = prazo.segundosRestantes();
+
+    if (sucesso) {
+        gerador.setGradeHoraria(resultadoConstrucao.grades.front());
+    }
 
     if (sucesso) {
         std::cout << "\n\n========================================" << std::endl;
@@ -415,27 +168,55 @@ int main(int argc, char* argv[]) {
             std::cout << "      INICIANDO FASE 2: MELHORAMENTO" << std::endl;
             std::cout << "========================================" << std::endl;
 
-            ConfiguracaoSA configSA;
-            configSA.numIteracoes = 10000;
-            configSA.temperaturaInicial = 100.0;
-            configSA.taxaResfriamento = 0.95;
-            configSA.verboso = true;
-
-            SimulatedAnnealing sa(
-                gerador.getGradeHoraria(),
-                professores,
-                disciplinas,
-                turmas,
-                salas,
-                disponibilidade,
-                turmaSalaMap,
-                configSA
-            );
-
-            sa.executar();
-            sa.mostrarEstatisticas();
-
-            gerador.setGradeHoraria(sa.getSolucaoFinal());
+            // A espera pela resposta acima não consome o prazo: a Fase 2
+            // fica com o que restou ao fim da Fase 1
+            Prazo prazoFase2 = prazo.ilimitado() ? Prazo() : Prazo::emSegundos(restanteFase1);
+
+            if (usarIlhas) {
+                // Um SA por núcleo, com variações de resfriamento, tabu e pesos
+                ConfiguracaoIlhas configIlhas;
+                configIlhas.configuracaoBase.numIteracoes = 10000;
+                configIlhas.configuracaoBase.temperaturaInicial = 100.0;
+                configIlhas.configuracaoBase.taxaResfriamento = 0.95;
+                configIlhas.configuracaoBase.semente = semente;
+                configIlhas.configuracaoBase.prazo = prazoFase2;
+                configIlhas.configuracaoBase.janelaConvergencia = janelaConvergencia;
+                configIlhas.intervaloMigracao = 500;
+                configIlhas.verboso = true;
+
+                ModeloIlhas otimizador(
+                    gerador.getGradeHoraria(),
+                    gerador.getInstancia(),
+                    configIlhas
+                );
+
+                otimizador.executar();
+                otimizador.mostrarEstatisticas();
+
+                gerador.setGradeHoraria(otimizador.getSolucaoFinal());
+            } else {
+                // Réplicas em temperaturas fixas entre 0.5 e 100, uma por núcleo
+                ConfiguracaoTemperaturaParalela configPT;
+                configPT.temperaturaMinima = 0.5;
+                configPT.temperaturaMaxima = 100.0;
+                configPT.numRodadas = 40;
+                configPT.passosPorRodada = 250;
+                configPT.configSA.semente = semente;
+                configPT.configSA.prazo = prazoFase2;
+                configPT.configSA.janelaConvergencia = janelaConvergencia;
+                configPT.verboso = true;
+
+                TemperaturaParalela otimizador(
+                    gerador.getGradeHoraria(),
+                    gerador.getInstancia(),
+                    configPT
+                );
+
+                otimizador.executar();
+                otimizador.mostrarEstatisticas();
+
+                gerador.setGradeHoraria(otimizador.getSolucaoFinal());
+            }
 
             std::cout << "\n=== GRADE HORARIA FINAL (APOS MELHORAMENTO) ===" << std::endl;
             gerador.imprimirHorario();
@@ -447,7 +228,11 @@ int main(int argc, char* argv[]) {
         std::cout << "           FALHA NA GERACAO" << std::endl;
         std::cout << "========================================" << std::endl;
         std::cout << "Nao foi possivel encontrar uma solucao completa apos "
-                  << MAX_TENTATIVAS << " tentativas." << std::endl;
+                  << tentativasRealizadas << " tentativas";
+        if (resultadoConstrucao.prazoEsgotado) {
+            std::cout << " (prazo de " << tempoLimite << " s esgotado)";
+        }
+        std::cout << "." << std::endl;
         std::cout << "Tempo total: " << duration.count() << " ms" << std::endl;
         std::cout << "========================================" << std::endl;
     }
@@ -0,0 +1,237 @@
+#include "ModeloIlhas.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+ModeloIlhas::ModeloIlhas(
+    std::vector<Aula> solucaoInicial,
+    std::shared_ptr<const InstanciaCompilada> instancia,
+    ConfiguracaoIlhas config)
+    : config(config), instancia(std::move(instancia)),
+      melhorIlha(0), melhorCusto(0.0), custoInicial(0.0), tempoExecucao(0.0)
+{
+    configuracoes = config.configuracoes;
+    if (configuracoes.empty()) {
+        int numIlhas = config.numIlhas;
+        if (numIlhas <= 0) {
+            numIlhas = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+        }
+        configuracoes = gerarConfiguracoesVariadas(config.configuracaoBase, numIlhas);
+    }
+
+    // Fluxo i da semente mestre para a ilha i. O momento em que cada elite
+    // chega depende do escalonamento das threads, então só a execução sem
+    // migração é reproduzível bit a bit
+    uint64_t semente = config.configuracaoBase.semente != 0 ? config.configuracaoBase.semente
+                                                            : sementeNaoDeterministica();
+
+    for (size_t i = 0; i < configuracoes.size(); i++) {
+        ConfiguracaoSA configIlha = configuracoes[i];
+        configIlha.verboso = false;
+        configIlha.threadsPolimento = 1; // As ilhas já ocupam os núcleos
+
+        auto ilha = std::make_unique<SimulatedAnnealing>(solucaoInicial, this->instancia, configIlha);
+
+        ilha->setAleatorio(Aleatorio::fluxo(semente, i));
+
+        ilhas.push_back(std::move(ilha));
+    }
+
+    caixas = std::make_unique<CaixaMensagens[]>(ilhas.size());
+    migracoesRecebidas.assign(ilhas.size(), 0);
+    custosReferencia.assign(ilhas.size(), 0.0);
+    temposIlha.assign(ilhas.size(), 0.0);
+
+    custoInicial = avaliarReferencia(solucaoInicial);
+    melhorCusto = custoInicial;
+}
+
+// Ilha 0 usa a base; as demais variam a velocidade de resfriamento, o tamanho
+// da memória tabu e os pesos de distribuição, consecutivas e janelas
+std::vector<ConfiguracaoSA> ModeloIlhas::gerarConfiguracoesVariadas(const ConfiguracaoSA& base, int numIlhas) {
+    static const double fatoresResfriamento[] = {1.0, 0.5, 2.0, 0.25};
+    static const int tamanhosTabu[] = {50, 20, 100, 10};
+    static const double fatoresPeso[] = {1.0, 1.25, 0.8};
+
+    std::vector<ConfiguracaoSA> configuracoes;
+    for (int i = 0; i < std::max(numIlhas, 1); i++) {
+        ConfiguracaoSA c = base;
+        if (i > 0) {
+            c.taxaResfriamento = 1.0 - (1.0 - base.taxaResfriamento) * fatoresResfriamento[i % 4];
+            c.tamanhoListaTabu = tamanhosTabu[(i / 4) % 4];
+            c.pesoDistribuicao = base.pesoDistribuicao * fatoresPeso[i % 3];
+            c.pesoConsecutivas = base.pesoConsecutivas * fatoresPeso[(i + 1) % 3];
+            c.pesoJanelas = base.pesoJanelas * fatoresPeso[(i + 2) % 3];
+        }
+        configuracoes.push_back(c);
+    }
+    return configuracoes;
+}
+
+// Custo segundo os pesos de referência, comparável entre ilhas
+double ModeloIlhas::avaliarReferencia(const std::vector<Aula>& solucao) const {
+    ConfiguracaoSA configReferencia = config.configuracaoBase;
+    configReferencia.verboso = false;
+    configReferencia.capacidadeCacheCusto = 1;
+    SimulatedAnnealing avaliador(solucao, instancia, configReferencia);
+    return avaliador.getCustoFinal();
+}
+
+void ModeloIlhas::executar() {
+    auto inicio = std::chrono::high_resolution_clock::now();
+
+    if (config.verboso) {
+        std::cout << "\n=== INICIANDO MODELO DE ILHAS ===" << std::endl;
+        std::cout << "Ilhas: " << ilhas.size() << " | Migração a cada "
+                  << config.intervaloMigracao << " iterações" << std::endl;
+    }
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // WebAssembly sem threads: ilhas em sequência, cada uma recebendo a
+    // última elite enviada pela anterior
+    for (size_t i = 0; i < ilhas.size(); i++) {
+        executarIlha(static_cast<int>(i));
+    }
+#else
+    std::vector<std::thread> threads;
+    threads.reserve(ilhas.size());
+    for (size_t i = 0; i < ilhas.size(); i++) {
+        threads.emplace_back(&ModeloIlhas::executarIlha, this, static_cast<int>(i));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+#endif
+
+    // Melhor solução global segundo os pesos de referência
+    for (size_t i = 0; i < ilhas.size(); i++) {
+        custosReferencia[i] = avaliarReferencia(ilhas[i]->getSolucaoFinal());
+        if (i == 0 || custosReferencia[i] < melhorCusto) {
+            melhorCusto = custosReferencia[i];
+            melhorIlha = static_cast<int>(i);
+        }
+    }
+
+    auto fim = std::chrono::high_resolution_clock::now();
+    tempoExecucao = std::chrono::duration<double>(fim - inicio).count();
+
+    if (config.verboso) {
+        std::cout << "\n=== MODELO DE ILHAS CONCLUÍDO ===" << std::endl;
+        std::cout << "Tempo de execução: " << std::fixed << std::setprecision(2)
+                  << tempoExecucao << "s" << std::endl;
+        std::cout << "Custo inicial: " << custoInicial << std::endl;
+        std::cout << "Custo final: " << melhorCusto << " (ilha " << melhorIlha << ")" << std::endl;
+    }
+}
+
+void ModeloIlhas::executarIlha(int indice) {
+    auto inicio = std::chrono::high_resolution_clock::now();
+    int proximaMigracao = std::max(config.intervaloMigracao, 1);
+
+    ilhas[indice]->executarComCallback([&](int iteracao, double, double) {
+        if (iteracao >= proximaMigracao) {
+            migrar(indice);
+            proximaMigracao += std::max(config.intervaloMigracao, 1);
+        }
+    });
+
+    auto fim = std::chrono::high_resolution_clock::now();
+    temposIlha[indice] = std::chrono::duration<double>(fim - inicio).count();
+}
+
+// Envia a elite para a ilha seguinte do anel e adota a recebida, se melhor
+void ModeloIlhas::migrar(int indice) {
+    if (ilhas.size() < 2) {
+        return;
+    }
+
+    size_t destino = (indice + 1) % ilhas.size();
+    caixas[destino].enviar(new Elite{ilhas[indice]->getMelhorSolucaoCompacta()});
+
+    std::unique_ptr<Elite> recebida = caixas[indice].receber();
+    if (recebida) {
+        migracoesRecebidas[indice]++;
+        ilhas[indice]->adotarSolucao(recebida->solucao);
+    }
+}
+
+std::vector<Aula> ModeloIlhas::getSolucaoFinal() const {
+    return ilhas[melhorIlha]->getSolucaoFinal();
+}
+
+EstatisticasSA ModeloIlhas::getEstatisticas() const {
+    EstatisticasSA total = ilhas[melhorIlha]->getEstatisticas(); // Histórico da melhor ilha
+    total.movimentosAceitos = 0;
+    total.movimentosRejeitados = 0;
+    total.movimentosMelhoria = 0;
+    total.movimentosPiora = 0;
+    total.reaquecimentos = 0;
+    total.migracoesAdotadas = 0;
+    total.iteracoesExecutadas = 0;
+    total.porMovimento = {};
+    total.pesosMovimento.fill(0.0);
+
+    for (size_t i = 0; i < ilhas.size(); i++) {
+        EstatisticasSA e = ilhas[i]->getEstatisticas();
+        total.movimentosAceitos += e.movimentosAceitos;
+        total.movimentosRejeitados += e.movimentosRejeitados;
+        total.movimentosMelhoria += e.movimentosMelhoria;
+        total.movimentosPiora += e.movimentosPiora;
+        total.reaquecimentos += e.reaquecimentos;
+        total.migracoesAdotadas += e.migracoesAdotadas;
+        total.iteracoesExecutadas += e.iteracoesExecutadas;
+        for (int t = 0; t < NUM_TIPOS_MOVIMENTO; t++) {
+            total.porMovimento[t].acumular(e.porMovimento[t]);
+            total.pesosMovimento[t] += e.pesosMovimento[t] / ilhas.size(); // Média das ilhas
+        }
+
+        EstatisticasIlha ilha;
+        ilha.movimentosAceitos = e.movimentosAceitos;
+        ilha.movimentosRejeitados = e.movimentosRejeitados;
+        ilha.reaquecimentos = e.reaquecimentos;
+        ilha.migracoesRecebidas = migracoesRecebidas[i];
+        ilha.migracoesAdotadas = e.migracoesAdotadas;
+        ilha.custoFinal = ilhas[i]->getCustoFinal();
+        ilha.custoReferencia = custosReferencia[i];
+        ilha.tempoExecucao = temposIlha[i];
+        total.ilhas.push_back(ilha);
+    }
+
+    total.custoInicial = custoInicial;
+    total.custoFinal = melhorCusto;
+    total.melhorCusto = melhorCusto;
+    total.tempoExecucao = tempoExecucao;
+    return total;
+}
+
+void ModeloIlhas::mostrarEstatisticas() const {
+    EstatisticasSA total = getEstatisticas();
+
+    std::cout << "\n=== ESTATÍSTICAS DO MODELO DE ILHAS ===" << std::endl;
+    std::cout << "Tempo de execução: " << std::fixed << std::setprecision(2)
+              << total.tempoExecucao << "s" << std::endl;
+    std::cout << "Movimentos aceitos: " << total.movimentosAceitos << std::endl;
+    std::cout << "Movimentos rejeitados: " << total.movimentosRejeitados << std::endl;
+    std::cout << "Taxa de aceitação: " << total.getTaxaAceitacao() << "%" << std::endl;
+    std::cout << "Reaquecimentos: " << total.reaquecimentos << std::endl;
+    std::cout << "Iterações: " << total.iteracoesExecutadas << " (parada da melhor ilha: "
+              << nomeCriterioParada(total.criterioParada) << ")" << std::endl;
+    std::cout << "Migrações adotadas: " << total.migracoesAdotadas << std::endl;
+    std::cout << "Custo inicial: " << total.custoInicial << std::endl;
+    std::cout << "Custo final: " << total.custoFinal << " (ilha " << melhorIlha << ")" << std::endl;
+
+    mostrarTelemetriaMovimentos(total);
+
+    std::cout << "\nIlha | Resfriamento | Tabu | Custo próprio | Custo referência | Migrações (adotadas/recebidas)" << std::endl;
+    for (size_t i = 0; i < total.ilhas.size(); i++) {
+        const auto& ilha = total.ilhas[i];
+        std::cout << std::setw(4) << i << " | "
+                  << std::setw(12) << std::setprecision(4) << configuracoes[i].taxaResfriamento << " | "
+                  << std::setw(4) << configuracoes[i].tamanhoListaTabu << " | "
+                  << std::setprecision(2) << std::setw(13) << ilha.custoFinal << " | "
+                  << std::setw(16) << ilha.custoReferencia << " | "
+                  << ilha.migracoesAdotadas << "/" << ilha.migracoesRecebidas << std::endl;
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "Estruturas.h"
+#include "InstanciaCompilada.h"
+#include "SimulatedAnnealing.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+
+// ==============================================================================
+// MODELO DE ILHAS (SA PARALELO COM MIGRAÇÃO)
+// ==============================================================================
+
+// Configurações do modelo de ilhas
+struct ConfiguracaoIlhas {
+    int numIlhas = 0;                 // 0 = std::thread::hardware_concurrency()
+    int intervaloMigracao = 500;      // Iterações de cada ilha entre migrações
+    bool verboso = false;
+
+    // Configuração de cada ilha; se vazia, as ilhas usam variações de
+    // configuracaoBase (gerarConfiguracoesVariadas)
+    std::vector<ConfiguracaoSA> configuracoes;
+    ConfiguracaoSA configuracaoBase;  // Também define os pesos de referência e a semente mestre
+};
+
+// Uma execução independente do SA por thread, cada uma com a própria
+// ConfiguracaoSA (pesos, resfriamento, memória tabu). A cada
+// intervaloMigracao iterações, cada ilha envia a sua melhor solução para a
+// caixa de mensagens da ilha seguinte (anel) e lê a própria caixa, adotando
+// a solução recebida se ela for melhor segundo os seus pesos. A caixa guarda
+// um único ponteiro atômico: enviar troca a mensagem anterior pela nova e
+// receber troca a mensagem por nulo, sem travas. O resultado é a melhor
+// solução de todas as ilhas segundo os pesos de configuracaoBase.
+class ModeloIlhas {
+public:
+    ModeloIlhas(
+        std::vector<Aula> solucaoInicial,
+        std::shared_ptr<const InstanciaCompilada> instancia,
+        ConfiguracaoIlhas config = ConfiguracaoIlhas()
+    );
+
+    void executar();
+
+    // Acesso aos resultados
+    std::vector<Aula> getSolucaoFinal() const;
+    double getCustoFinal() const { return melhorCusto; }
+    EstatisticasSA getEstatisticas() const; // Contadores somados e resumo por ilha
+    int getNumIlhas() const { return static_cast<int>(ilhas.size()); }
+
+    void mostrarEstatisticas() const;
+
+    // Variações de resfriamento, memória tabu e pesos em torno de uma base
+    static std::vector<ConfiguracaoSA> gerarConfiguracoesVariadas(const ConfiguracaoSA& base, int numIlhas);
+
+private:
+    // Mensagem de migração: melhor solução de uma ilha
+    struct Elite {
+        std::vector<AulaCompacta> solucao;
+    };
+
+    // Caixa de mensagens de uma única posição, sem travas
+    struct CaixaMensagens {
+        std::atomic<Elite*> mensagem{nullptr};
+
+        void enviar(Elite* elite) { delete mensagem.exchange(elite, std::memory_order_acq_rel); }
+        std::unique_ptr<Elite> receber() {
+            return std::unique_ptr<Elite>(mensagem.exchange(nullptr, std::memory_order_acq_rel));
+        }
+        ~CaixaMensagens() { delete mensagem.load(); }
+    };
+
+    ConfiguracaoIlhas config;
+    std::shared_ptr<const InstanciaCompilada> instancia;
+    std::vector<std::unique_ptr<SimulatedAnnealing>> ilhas;
+    std::vector<ConfiguracaoSA> configuracoes;
+    std::unique_ptr<CaixaMensagens[]> caixas;
+    std::vector<int> migracoesRecebidas;
+    std::vector<double> custosReferencia;
+    std::vector<double> temposIlha;
+
+    int melhorIlha;
+    double melhorCusto;
+    double custoInicial;
+    double tempoExecucao;
+
+    void executarIlha(int indice);
+    void migrar(int indice);
+    double avaliarReferencia(const std::vector<Aula>& solucao) const;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+// ==============================================================================
+// PRAZO DE EXECUÇÃO
+// ==============================================================================
+
+// Instante limite no relógio monotônico, compartilhado pelas fases: a
+// construção para de iniciar tentativas e o SA para de iterar quando ele
+// passa, ficando com a melhor solução encontrada até ali. Cópias guardam o
+// mesmo instante, então o prazo é criado uma vez e repassado às
+// configurações. O padrão é ilimitado.
+class Prazo {
+public:
+    using Relogio = std::chrono::steady_clock;
+
+    Prazo() : limitado(false) {}
+
+    // Prazo que termina `segundos` a partir de agora (0 = já esgotado)
+    static Prazo emSegundos(double segundos) {
+        Prazo prazo;
+        prazo.limitado = true;
+        prazo.fim = Relogio::now() + std::chrono::duration_cast<Relogio::duration>(
+                                         std::chrono::duration<double>(std::max(segundos, 0.0)));
+        return prazo;
+    }
+
+    bool ilimitado() const { return !limitado; }
+    bool esgotado() const { return limitado && Relogio::now() >= fim; }
+
+    // Segundos até o fim (infinito se ilimitado, 0 se esgotado)
+    double segundosRestantes() const {
+        if (!limitado) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return std::max(std::chrono::duration<double>(fim - Relogio::now()).count(), 0.0);
+    }
+
+private:
+    bool limitado;
+    Relogio::time_point fim;
+};
@@ -1,12 +1,74 @@
 #include "SimulatedAnnealing.h"
+#include "Barreira.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
 #include <chrono>
 #include <fstream>
+#include <mutex>
 #include <numeric>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Polimento: melhoria mínima aplicada (evita ciclos por arredondamento)
+constexpr double LIMIAR_MELHORIA_POLIMENTO = 1e-9;
+// Aulas por bloco da varredura na primeira melhoria
+constexpr int BLOCO_PRIMEIRA_MELHORIA = 64;
+// Abaixo disso por thread, a varredura não compensa a criação das threads
+constexpr int AULAS_MINIMAS_POR_THREAD = 128;
+
+// Seleção adaptativa: suavização da recompensa média de um tipo a cada
+// proposta dele e passo das probabilidades em direção ao alvo a cada iteração
+constexpr double TAXA_RECOMPENSA = 0.05;
+constexpr double TAXA_PERSEGUICAO = 0.01;
+// Propostas de um tipo de movimento após as quais, se nenhuma foi viável, ele
+// sai da seleção
+constexpr int PROPOSTAS_AQUECIMENTO_MOVIMENTO = 500;
+
+// Iterações entre consultas ao relógio do prazo
+constexpr int INTERVALO_VERIFICACAO_PRAZO = 64;
+
+// Slots de um horário em todos os dias
+constexpr MascaraSlots MASCARA_HORA = [] {
+    MascaraSlots mascara = 0;
+    for (int dia = 0; dia < NUM_DIAS; dia++) {
+        mascara |= 1u << (dia * NUM_HORARIOS);
+    }
+    return mascara;
+}();
+
+// Índice de um bit sorteado uniformemente entre os ligados (máscara não vazia)
+int sortearBit(MascaraSlots mascara, Aleatorio& gen) {
+    for (uint32_t k = gen.inteiro(__builtin_popcount(mascara)); k > 0; k--) {
+        mascara &= mascara - 1;
+    }
+    return __builtin_ctz(mascara);
+}
+
+// Tabela Zobrist com pelo menos `tamanho` valores, compartilhada por todas as
+// instâncias do processo (réplicas e ilhas). A semente é fixa, então uma
+// tabela maior começa pelos mesmos valores e serve também às menores
+std::shared_ptr<const std::vector<uint64_t>> tabelaZobristCompartilhada(size_t tamanho) {
+    static std::mutex mutex;
+    static std::shared_ptr<const std::vector<uint64_t>> tabela;
+
+    std::lock_guard<std::mutex> trava(mutex);
+    if (!tabela || tabela->size() < tamanho) {
+        std::mt19937_64 geradorZobrist(0x5A0B4157ULL);
+        auto valores = std::make_shared<std::vector<uint64_t>>(tamanho);
+        for (auto& valor : *valores) {
+            valor = geradorZobrist();
+        }
+        tabela = std::move(valores);
+    }
+    return tabela;
+}
+
+} // namespace
 
 // Construtor
 SimulatedAnnealing::SimulatedAnnealing(
@@ -18,20 +80,131 @@ SimulatedAnnealing::SimulatedAnnealing(
     std::set<std::tuple<int, int, int>> disponibilidadeProfessores,
     std::map<int, int> turmaSalaMap,
     ConfiguracaoSA config)
-    : solucaoAtual(solucaoInicial), melhorSolucao(solucaoInicial),
-      professores(professores), disciplinas(disciplinas),
-      turmas(turmas), salas(salas),
-      disponibilidadeProfessores(disponibilidadeProfessores),
-      turmaSalaMap(turmaSalaMap),
+    : SimulatedAnnealing(std::move(solucaoInicial),
+                         std::make_shared<const InstanciaCompilada>(
+                             professores, disciplinas, turmas, salas,
+                             disponibilidadeProfessores, turmaSalaMap),
+                         config)
+{
+}
+
+SimulatedAnnealing::SimulatedAnnealing(
+    std::vector<Aula> solucaoInicial,
+    std::shared_ptr<const InstanciaCompilada> instancia,
+    ConfiguracaoSA config)
+    : instancia(std::move(instancia)),
+      aulasOriginais(std::move(solucaoInicial)),
       config(config),
       temperaturaAtual(config.temperaturaInicial),
       executando(false),
-      gen(std::chrono::steady_clock::now().time_since_epoch().count()),
-      dis(0.0, 1.0),
-      disMovimento(0, 6) // 7 tipos de movimento
+      iteracoesExecutadas(0),
+      gen(config.semente != 0 ? config.semente : sementeNaoDeterministica()),
+      cacheCusto(std::max(config.capacidadeCacheCusto, 1))
 {
+    // Traduzir as aulas para a representação compacta
+    // (lança std::invalid_argument para professor, turma ou disciplina inexistente)
+    solucaoAtual.reserve(aulasOriginais.size());
+    for (const auto& aula : aulasOriginais) {
+        solucaoAtual.push_back(this->instancia->compactarAula(aula));
+    }
+    melhorSolucao = solucaoAtual;
+
+    aulasPorTurma.assign(this->instancia->numTurmas(), {});
+    aulasPorProfessor.assign(this->instancia->numProfessores(), {});
+    aulasPorSala.assign(this->instancia->numSalas(), {});
+    for (size_t i = 0; i < solucaoAtual.size(); i++) {
+        aulasPorTurma[solucaoAtual[i].turma].push_back(static_cast<int>(i));
+        aulasPorProfessor[solucaoAtual[i].professor].push_back(static_cast<int>(i));
+        int sala = solucaoAtual[i].sala;
+        if (sala >= 0 && !this->instancia->salaCompartilhada(sala)) {
+            aulasPorSala[sala].push_back(static_cast<int>(i));
+        }
+    }
+    grupoDaAula.assign(solucaoAtual.size(), 0);
+    for (const auto& aulas : aulasPorTurma) {
+        primeiroGrupoTurma.push_back(static_cast<int>(aulasPorGrupo.size()));
+        for (int i : aulas) {
+            size_t g = primeiroGrupoTurma.back();
+            while (g < aulasPorGrupo.size() &&
+                   solucaoAtual[aulasPorGrupo[g].front()].disciplina != solucaoAtual[i].disciplina) {
+                g++;
+            }
+            if (g == aulasPorGrupo.size()) {
+                aulasPorGrupo.emplace_back();
+            }
+            aulasPorGrupo[g].push_back(i);
+            grupoDaAula[i] = static_cast<int>(g);
+        }
+    }
+    primeiroGrupoTurma.push_back(static_cast<int>(aulasPorGrupo.size()));
+    representanteAula.assign(solucaoAtual.size(), 0);
+    numRepresentantes = 0;
+    for (const auto& aulas : aulasPorGrupo) {
+        for (int i : aulas) {
+            representanteAula[i] = -1;
+            for (int j : aulas) {
+                if (j == i) break;
+                if (solucaoAtual[j].professor == solucaoAtual[i].professor &&
+                    solucaoAtual[j].sala == solucaoAtual[i].sala) {
+                    representanteAula[i] = representanteAula[j];
+                    break;
+                }
+            }
+            if (representanteAula[i] < 0) representanteAula[i] = numRepresentantes++;
+        }
+    }
+
+    // Blocos geminados: aulas idênticas seguidas, pareadas a partir do
+    // horário mais cedo de cada grupo de disciplina geminada
+    parceiroGeminada.assign(solucaoAtual.size(), -1);
+    paresGeminadosPorTurma.assign(this->instancia->numTurmas(), {});
+    for (const auto& aulas : aulasPorGrupo) {
+        if (!this->instancia->disciplinaGeminada(solucaoAtual[aulas.front()].disciplina)) continue;
+
+        std::vector<int> ordenadas = aulas;
+        std::sort(ordenadas.begin(), ordenadas.end(),
+                  [&](int a, int b) { return solucaoAtual[a].slot < solucaoAtual[b].slot; });
+        for (size_t k = 0; k + 1 < ordenadas.size(); k++) {
+            int a = ordenadas[k];
+            int b = ordenadas[k + 1];
+            MascaraSlots slots = InstanciaCompilada::bitSlot(solucaoAtual[a].slot) |
+                                 InstanciaCompilada::bitSlot(solucaoAtual[b].slot);
+            if (iniciosGeminada(slots) && aulasIdenticas(a, b)) {
+                parceiroGeminada[a] = b;
+                parceiroGeminada[b] = a;
+                paresGeminadosPorTurma[solucaoAtual[a].turma].push_back(static_cast<int>(paresGeminados.size()));
+                paresGeminados.push_back({a, b});
+                k++;
+            }
+        }
+    }
+    for (size_t i = 0; i < solucaoAtual.size(); i++) {
+        if (parceiroGeminada[i] < 0) aulasAvulsas.push_back(static_cast<int>(i));
+    }
+    for (int t = 0; t < NUM_TIPOS_MOVIMENTO; t++) {
+        auto tipo = static_cast<TipoMovimento>(t);
+        if (tipo == TipoMovimento::OTIMIZAR_TURMA) continue; // Sem implementação
+        if (tipo == TipoMovimento::MOVER_GEMINADA && paresGeminados.empty()) continue;
+        tiposAtivos.push_back(t);
+    }
+    estatisticas.pesosMovimento.fill(0.0);
+    for (int t : tiposAtivos) {
+        estatisticas.pesosMovimento[t] = 1.0 / tiposAtivos.size();
+    }
+    recompensaMovimento.fill(0.0);
+    inicializarContribuicoes(solucaoAtual);
+    reconstruirOcupacao();
+
+    tabelaZobrist = tabelaZobristCompartilhada(static_cast<size_t>(numRepresentantes) * NUM_SLOTS);
+    hashAtual = calcularHash(solucaoAtual);
+
+    anelTabu.assign(std::max(config.tamanhoListaTabu, 0), 0);
+    contagemTabu.assign(static_cast<size_t>(numRepresentantes) * NUM_SLOTS, 0);
+    posicaoAnelTabu = 0;
+    ocupacaoAnelTabu = 0;
+
     // Calcular custo inicial
-    estatisticas.custoInicial = calcularCusto(solucaoAtual);
+    estatisticas.custoInicial = calcularCusto(solucaoAtual, hashAtual);
     estatisticas.custoFinal = estatisticas.custoInicial;
     melhorCusto = estatisticas.custoInicial;
 
@@ -40,6 +213,15 @@ SimulatedAnnealing::SimulatedAnnealing(
     log("Temperatura inicial: " + std::to_string(config.temperaturaInicial));
 }
 
+// Solução final com os IDs e metadados das aulas recebidas
+std::vector<Aula> SimulatedAnnealing::getSolucaoFinal() const {
+    std::vector<Aula> solucao = aulasOriginais;
+    for (size_t i = 0; i < solucao.size(); i++) {
+        solucao[i].slot = melhorSolucao[i].getSlot();
+    }
+    return solucao;
+}
+
 // Logging
 void SimulatedAnnealing::log(const std::string& mensagem) const {
     if (config.verboso) {
@@ -71,72 +253,51 @@ void SimulatedAnnealing::executarComCallback(std::function<void(int, double, dou
     auto inicio = std::chrono::high_resolution_clock::now();
     executando = true;
 
-    std::cout << "\n=== INICIANDO SIMULATED ANNEALING ===" << std::endl;
-    std::cout << "Configuração:" << std::endl;
-    std::cout << "  Iterações: " << config.numIteracoes << std::endl;
-    std::cout << "  Temperatura inicial: " << config.temperaturaInicial << std::endl;
-    std::cout << "  Taxa de resfriamento: " << config.taxaResfriamento << std::endl;
-    std::cout << "  Usar reaquecimento: " << (config.usarReaquecimento ? "Sim" : "Não") << std::endl;
-    std::cout << "  Usar memória tabu: " << (config.usarMemoriaTabu ? "Sim" : "Não") << std::endl;
+    if (config.verboso) {
+        std::cout << "\n=== INICIANDO SIMULATED ANNEALING ===" << std::endl;
+        std::cout << "Configuração:" << std::endl;
+        std::cout << "  Iterações: " << config.numIteracoes << std::endl;
+        std::cout << "  Temperatura inicial: " << config.temperaturaInicial << std::endl;
+        std::cout << "  Taxa de resfriamento: " << config.taxaResfriamento << std::endl;
+        std::cout << "  Usar reaquecimento: " << (config.usarReaquecimento ? "Sim" : "Não") << std::endl;
+        std::cout << "  Usar memória tabu: " << (config.usarMemoriaTabu ? "Sim" : "Não") << std::endl;
+    }
 
     int iteracoesSemMelhoria = 0;
     int iteracoesDesdeRelatorio = 0;
 
-    for (int iter = 0; iter < config.numIteracoes && executando; iter++) {
-        // Gerar movimento
-        Movimento movimento = selecionarMovimento();
+    // Janela de convergência: conta a partir da última iteração em que o
+    // melhor custo caiu (inclusive por solução adotada de outra ilha)
+    int inicioJanela = 0;
+    double melhorCustoJanela = melhorCusto;
+    estatisticas.criterioParada = CriterioParada::ITERACOES;
 
-        // Verificar se não é tabu
-        if (config.usarMemoriaTabu && movimentoTabu(movimento)) {
-            estatisticas.movimentosRejeitados++;
-            continue;
+    int iter = 0;
+    for (; iter < config.numIteracoes; iter++) {
+        if (!executando) {
+            estatisticas.criterioParada = CriterioParada::INTERROMPIDO;
+            break;
+        }
+        if (iter % INTERVALO_VERIFICACAO_PRAZO == 0 && config.prazo.esgotado()) {
+            estatisticas.criterioParada = CriterioParada::PRAZO;
+            break;
+        }
+        if (melhorCusto < melhorCustoJanela) {
+            melhorCustoJanela = melhorCusto;
+            inicioJanela = iter;
+        } else if (config.janelaConvergencia > 0 && iter - inicioJanela >= config.janelaConvergencia) {
+            estatisticas.criterioParada = CriterioParada::CONVERGENCIA;
+            break;
         }
 
-        // Gerar solução vizinha
-        std::vector<Aula> vizinho = gerarVizinho(solucaoAtual);
-
-        // Verificar viabilidade rápida
-        if (!verificarViabilidadeRapida(vizinho, movimento)) {
-            estatisticas.movimentosRejeitados++;
+        ResultadoIteracao resultado = executarIteracao(iter);
+        if (resultado == ResultadoIteracao::INVIAVEL || resultado == ResultadoIteracao::TABU) {
             continue;
         }
 
-        // Calcular custo
-        double custoVizinho = calcularCusto(vizinho);
-        double deltaCusto = custoVizinho - estatisticas.custoFinal;
-
-        // Decidir se aceita
-        if (aceitarMovimento(deltaCusto)) {
-            solucaoAtual = vizinho;
-            estatisticas.custoFinal = custoVizinho;
-            estatisticas.movimentosAceitos++;
-
-            if (deltaCusto < 0) {
-                estatisticas.movimentosMelhoria++;
-            } else {
-                estatisticas.movimentosPiora++;
-            }
-
-            // Adicionar à lista tabu
-            if (config.usarMemoriaTabu) {
-                adicionarTabu(movimento);
-            }
-
-            // Atualizar melhor solução
-            if (custoVizinho < melhorCusto) {
-                melhorSolucao = solucaoAtual;
-                melhorCusto = custoVizinho;
-                estatisticas.iteracaoMelhorCusto = iter;
-                iteracoesSemMelhoria = 0;
-
-                log("Iteração " + std::to_string(iter) +
-                    ": Novo melhor custo = " + std::to_string(melhorCusto) +
-                    " (T=" + std::to_string(temperaturaAtual) + ")");
-            } else {
-                iteracoesSemMelhoria++;
-            }
+        if (resultado == ResultadoIteracao::NOVO_MELHOR) {
+            iteracoesSemMelhoria = 0;
         } else {
-            estatisticas.movimentosRejeitados++;
             iteracoesSemMelhoria++;
         }
 
@@ -164,7 +325,7 @@ void SimulatedAnnealing::executarComCallback(std::function<void(int, double, dou
 
         // Mostrar progresso
         iteracoesDesdeRelatorio++;
-        if (iteracoesDesdeRelatorio >= config.frequenciaRelatorio) {
+        if (config.verboso && iteracoesDesdeRelatorio >= config.frequenciaRelatorio) {
             double taxaAceitacao = estatisticas.getTaxaAceitacao();
             std::cout << "Progresso: " << std::setw(6) << (iter + 1)
                       << "/" << config.numIteracoes
@@ -177,192 +338,324 @@ void SimulatedAnnealing::executarComCallback(std::function<void(int, double, dou
         }
     }
 
+    estatisticas.iteracoesExecutadas += iter;
+
     auto fim = std::chrono::high_resolution_clock::now();
     auto duracao = std::chrono::duration_cast<std::chrono::milliseconds>(fim - inicio);
     estatisticas.tempoExecucao = duracao.count() / 1000.0;
 
     // Aplicar busca local final para refinar
-    if (estatisticas.custoFinal < estatisticas.custoInicial * 1.5) { // Só se a solução não for muito ruim
-        log("Aplicando busca local final...");
-        melhorSolucao = buscaLocal2opt(melhorSolucao);
-        melhorSolucao = buscaLocalJanelas(melhorSolucao);
-        melhorCusto = calcularCusto(melhorSolucao);
+    refinarMelhorSolucao();
+
+    if (config.verboso) {
+        std::cout << "\n=== SIMULATED ANNEALING CONCLUÍDO ===" << std::endl;
+        std::cout << "Parada: " << nomeCriterioParada(estatisticas.criterioParada)
+                  << " após " << iter << " iterações" << std::endl;
+        std::cout << "Tempo de execução: " << formatarTempo(estatisticas.tempoExecucao) << std::endl;
+        std::cout << "Custo inicial: " << estatisticas.custoInicial << std::endl;
+        std::cout << "Custo final: " << melhorCusto << std::endl;
+        std::cout << "Melhoria: " << std::fixed << std::setprecision(2)
+                  << estatisticas.getPercentualMelhoria() << "%" << std::endl;
     }
+}
 
-    std::cout << "\n=== SIMULATED ANNEALING CONCLUÍDO ===" << std::endl;
-    std::cout << "Tempo de execução: " << formatarTempo(estatisticas.tempoExecucao) << std::endl;
-    std::cout << "Custo inicial: " << estatisticas.custoInicial << std::endl;
-    std::cout << "Custo final: " << melhorCusto << std::endl;
-    std::cout << "Melhoria: " << std::fixed << std::setprecision(2)
-              << estatisticas.getPercentualMelhoria() << "%" << std::endl;
+// Uma iteração de Metropolis na temperatura atual: sorteia, aplica e avalia
+// o movimento, e o confirma ou desfaz. Registra a telemetria do tipo sorteado.
+SimulatedAnnealing::ResultadoIteracao SimulatedAnnealing::executarIteracao(int iter) {
+    auto inicio = std::chrono::steady_clock::now();
+
+    // Gerar movimento: o mesmo objeto guia a geração do vizinho,
+    // a verificação de viabilidade e a memória tabu
+    Movimento movimento = selecionarMovimento();
+    gerarVizinho(movimento);
+
+    auto gerado = std::chrono::steady_clock::now();
+    double deltaCusto = 0.0;
+    ResultadoIteracao resultado = avaliarMovimento(movimento, iter, deltaCusto);
+    auto fim = std::chrono::steady_clock::now();
+
+    // Recompensa da seleção adaptativa: melhoria aceita por aula tocada,
+    // medida do trabalho do movimento que não depende do relógio (mantém a
+    // execução reproduzível para a mesma semente)
+    if (config.selecaoAdaptativa) {
+        bool melhorou = (resultado == ResultadoIteracao::ACEITO || resultado == ResultadoIteracao::NOVO_MELHOR) &&
+                        deltaCusto < 0;
+        double recompensa = melhorou ? -deltaCusto / (1.0 + movimento.alteracoes.size()) : 0.0;
+        atualizarSelecaoAdaptativa(movimento.tipo, recompensa);
+    }
+
+    EstatisticasMovimento& telemetria = estatisticas.porMovimento[static_cast<int>(movimento.tipo)];
+    telemetria.propostos++;
+    telemetria.nsGeracao += std::chrono::duration_cast<std::chrono::nanoseconds>(gerado - inicio).count();
+    telemetria.nsAvaliacao += std::chrono::duration_cast<std::chrono::nanoseconds>(fim - gerado).count();
+
+    switch (resultado) {
+        case ResultadoIteracao::INVIAVEL:
+            telemetria.rejeitadosInviaveis++;
+            if (telemetria.propostos == PROPOSTAS_AQUECIMENTO_MOVIMENTO &&
+                telemetria.rejeitadosInviaveis == telemetria.propostos) {
+                desativarTipoMovimento(movimento.tipo);
+            }
+            return resultado;
+        case ResultadoIteracao::TABU:
+            telemetria.rejeitadosTabu++;
+            break;
+        case ResultadoIteracao::REJEITADO:
+            break;
+        case ResultadoIteracao::ACEITO:
+        case ResultadoIteracao::NOVO_MELHOR:
+            telemetria.aceitos++;
+            if (deltaCusto < 0) {
+                telemetria.melhorias++;
+            }
+            break;
+    }
+    telemetria.avaliados++;
+    telemetria.somaDelta += deltaCusto;
+
+    return resultado;
 }
 
-// Cálculo de custo total
-double SimulatedAnnealing::calcularCusto(const std::vector<Aula>& solucao) {
-    // Verificar cache
-    size_t hashSolucao = 0;
-    for (const auto& aula : solucao) {
-        hashSolucao ^= aula.getHash();
+// Viabilidade, aplicação, custo incremental, memória tabu e critério de
+// Metropolis de um movimento já gerado
+SimulatedAnnealing::ResultadoIteracao SimulatedAnnealing::avaliarMovimento(
+    const Movimento& movimento, int iter, double& deltaCusto) {
+    // Verificar viabilidade rápida (movimento vazio: nada a avaliar)
+    if (movimento.alteracoes.empty() || !preservaGeminadas(movimento) ||
+        !verificarViabilidadeRapida(movimento)) {
+        estatisticas.movimentosRejeitados++;
+        return ResultadoIteracao::INVIAVEL;
     }
 
-    auto it = cacheCusto.find(hashSolucao);
-    if (it != cacheCusto.end()) {
-        return it->second;
+    // Aplicar na solução atual e calcular custo (apenas as turmas, dias e
+    // professores afetados). Um vizinho já visto sai do cache pelo hash
+    // Zobrist, e as contribuições dele só são calculadas se for aceito
+    aplicarMovimento(movimento);
+    double custoVizinho = 0.0;
+    bool emCache = cacheCusto.buscar(hashAtual, custoVizinho);
+    if (!emCache) {
+        custoVizinho = calcularCustoIncremental(movimento);
+        cacheCusto.inserir(hashAtual, custoVizinho);
     }
+    deltaCusto = custoVizinho - estatisticas.custoFinal;
 
-    // Calcular custo
-    double custo = 0.0;
+    // Verificar se não é tabu (aspiração: aceito se supera a melhor solução)
+    if (config.usarMemoriaTabu && custoVizinho >= melhorCusto && movimentoTabu(movimento)) {
+        desfazerMovimento();
+        estatisticas.movimentosRejeitados++;
+        return ResultadoIteracao::TABU;
+    }
 
-    custo += config.pesoDistribuicao * calcularPenalidade1(solucao);
-    custo += config.pesoConsecutivas * calcularPenalidade2(solucao);
-    custo += config.pesoJanelas * calcularPenalidade3(solucao);
-    custo += config.pesoHorariosExtremos * calcularPenalidade4(solucao);
-    custo += config.pesoPreferencias * calcularPenalidade5(solucao);
+    // Decidir se aceita
+    if (!aceitarMovimento(deltaCusto)) {
+        desfazerMovimento();
+        estatisticas.movimentosRejeitados++;
+        return ResultadoIteracao::REJEITADO;
+    }
 
-    // Armazenar no cache
-    if (cacheCusto.size() > 1000) {
-        cacheCusto.clear(); // Limpar cache se ficar muito grande
+    if (emCache) {
+        custoVizinho = calcularCustoIncremental(movimento);
     }
-    cacheCusto[hashSolucao] = custo;
+    confirmarCustoIncremental();
+    registroDesfazer.clear();
+    estatisticas.custoFinal = custoVizinho;
+    estatisticas.movimentosAceitos++;
 
-    return custo;
+    if (deltaCusto < 0) {
+        estatisticas.movimentosMelhoria++;
+    } else {
+        estatisticas.movimentosPiora++;
+    }
+
+    // Adicionar à lista tabu
+    if (config.usarMemoriaTabu) {
+        adicionarTabu(movimento);
+    }
+
+    // Atualizar melhor solução
+    if (custoVizinho < melhorCusto) {
+        melhorSolucao = solucaoAtual;
+        melhorCusto = custoVizinho;
+        estatisticas.iteracaoMelhorCusto = iter;
+
+        log("Iteração " + std::to_string(iter) +
+            ": Novo melhor custo = " + std::to_string(melhorCusto) +
+            " (T=" + std::to_string(temperaturaAtual) + ")");
+        return ResultadoIteracao::NOVO_MELHOR;
+    }
+
+    return ResultadoIteracao::ACEITO;
 }
 
-// Penalidade 1: Distribuição desigual de aulas por dia
-double SimulatedAnnealing::calcularPenalidade1(const std::vector<Aula>& solucao) const {
-    double penalidade = 0.0;
+// Passos de Metropolis a temperatura fixa, sem resfriamento nem reaquecimento
+// (réplica de uma escada de temperaturas)
+void SimulatedAnnealing::executarPassos(int numPassos) {
+    auto inicio = std::chrono::high_resolution_clock::now();
 
-    for (const auto& turma : turmas) {
-        std::map<int, int> aulasPorDia;
-        int totalAulas = 0;
+    for (int passo = 0; passo < numPassos; passo++) {
+        executarIteracao(iteracoesExecutadas++);
+    }
+    estatisticas.iteracoesExecutadas += numPassos;
 
-        for (const auto& aula : solucao) {
-            if (aula.idTurma == turma.id) {
-                aulasPorDia[aula.slot.dia]++;
-                totalAulas++;
-            }
+    auto fim = std::chrono::high_resolution_clock::now();
+    estatisticas.tempoExecucao += std::chrono::duration<double>(fim - inicio).count();
+}
+
+// Adota uma solução vinda de outra execução sobre a mesma instância e as
+// mesmas aulas (posições iguais), se ela superar a melhor solução desta
+// execução segundo os pesos desta configuração
+bool SimulatedAnnealing::adotarSolucao(const std::vector<AulaCompacta>& solucao) {
+    if (solucao.size() != solucaoAtual.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < solucao.size(); i++) {
+        if (solucao[i].professor != solucaoAtual[i].professor ||
+            solucao[i].turma != solucaoAtual[i].turma ||
+            solucao[i].disciplina != solucaoAtual[i].disciplina) {
+            return false;
         }
+    }
 
-        if (totalAulas == 0) continue;
+    uint64_t hashSolucao = calcularHash(solucao);
+    double custo = calcularCusto(solucao, hashSolucao);
+    if (custo >= melhorCusto) {
+        return false;
+    }
 
-        // Calcular média ideal e desvio
-        double mediaIdeal = totalAulas / 5.0;
-        double variancia = 0.0;
+    definirSolucaoAtual(solucao, hashSolucao);
+    limparTabu();
 
-        for (int dia = 0; dia < 5; dia++) {
-            double desvio = aulasPorDia[dia] - mediaIdeal;
-            variancia += desvio * desvio;
-        }
+    estatisticas.custoFinal = custo;
+    melhorSolucao = solucaoAtual;
+    melhorCusto = custo;
+    estatisticas.migracoesAdotadas++;
+    return true;
+}
 
-        penalidade += std::sqrt(variancia / 5.0);
+// Substitui a solução atual, recalculando contribuições e ocupação
+void SimulatedAnnealing::definirSolucaoAtual(const std::vector<AulaCompacta>& solucao, uint64_t hashSolucao) {
+    solucaoAtual = solucao;
+    hashAtual = hashSolucao;
+    registroDesfazer.clear();
+    inicializarContribuicoes(solucaoAtual);
+    reconstruirOcupacao();
+}
 
-        // Penalizar dias muito carregados
-        for (const auto& [dia, qtd] : aulasPorDia) {
-            if (qtd > 7) { // Mais de 7 aulas em um dia é excessivo
-                penalidade += (qtd - 7) * 10;
-            }
-            if (qtd == 0) { // Dia sem aulas também não é ideal
-                penalidade += 5;
-            }
-        }
+// Busca local final sobre a melhor solução
+void SimulatedAnnealing::refinarMelhorSolucao() {
+    if (estatisticas.custoFinal < estatisticas.custoInicial * 1.5) { // Só se a solução não for muito ruim
+        log("Aplicando busca local final...");
+
+        // O polimento trabalha sobre a solução atual
+        definirSolucaoAtual(melhorSolucao, calcularHash(melhorSolucao));
+        estatisticas.custoFinal = combinarPenalidades(
+            contribuicoes.somaDistribuicao, contribuicoes.somaConsecutivas, contribuicoes.somaJanelas,
+            contribuicoes.somaExtremos, contribuicoes.somaPreferencias);
+        double custoAntes = estatisticas.custoFinal;
+        int aplicados = polirSolucaoAtual();
+        log("Polimento: " + std::to_string(aplicados) + " movimentos, custo " +
+            std::to_string(custoAntes) + " -> " + std::to_string(estatisticas.custoFinal));
+
+        // Com o prazo esgotado, o resultado do polimento já é o final
+        melhorSolucao = config.prazo.esgotado() ? solucaoAtual : buscaLocalJanelas(solucaoAtual);
+        melhorCusto = calcularCusto(melhorSolucao);
     }
+}
 
-    return penalidade;
+// Hash Zobrist completo de uma solução
+uint64_t SimulatedAnnealing::calcularHash(const std::vector<AulaCompacta>& solucao) const {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < solucao.size(); i++) {
+        hash ^= (*tabelaZobrist)[representanteAula[i] * NUM_SLOTS + solucao[i].slot];
+    }
+    return hash;
 }
 
-// Penalidade 2: Falta de aulas consecutivas (na verdade é bônus)
-double SimulatedAnnealing::calcularPenalidade2(const std::vector<Aula>& solucao) const {
-    double bonus = 0.0;
+// Cálculo de custo total
+double SimulatedAnnealing::calcularCusto(const std::vector<AulaCompacta>& solucao) {
+    return calcularCusto(solucao, calcularHash(solucao));
+}
 
-    // Analisar por turma e dia
-    for (const auto& turma : turmas) {
-        for (int dia = 0; dia < 5; dia++) {
-            std::map<int, std::vector<int>> aulasPorDisciplina;
+// Cálculo de custo total com o hash da solução já conhecido
+double SimulatedAnnealing::calcularCusto(const std::vector<AulaCompacta>& solucao,
+                                         uint64_t hashSolucao) {
+    // Verificar cache
+    double custo = 0.0;
+    if (cacheCusto.buscar(hashSolucao, custo)) {
+        return custo;
+    }
 
-            for (const auto& aula : solucao) {
-                if (aula.idTurma == turma.id && aula.slot.dia == dia) {
-                    aulasPorDisciplina[aula.idDisciplina].push_back(aula.slot.hora);
-                }
-            }
+    // Calcular custo
+    custo += config.pesoDistribuicao * calcularPenalidade1(solucao);
+    custo += config.pesoConsecutivas * calcularPenalidade2(solucao);
+    custo += config.pesoJanelas * calcularPenalidade3(solucao);
+    custo += config.pesoHorariosExtremos * calcularPenalidade4(solucao);
+    custo += config.pesoPreferencias * calcularPenalidade5(solucao);
 
-            // Verificar aulas consecutivas por disciplina
-            for (auto& [discId, horarios] : aulasPorDisciplina) {
-                if (horarios.size() < 2) continue;
-
-                std::sort(horarios.begin(), horarios.end());
-
-                // Contar sequências consecutivas
-                int sequenciaAtual = 1;
-                for (size_t i = 1; i < horarios.size(); i++) {
-                    if (horarios[i] == horarios[i-1] + 1) {
-                        sequenciaAtual++;
-                    } else {
-                        // Bonificar sequências (quanto maior, melhor)
-                        if (sequenciaAtual >= 2) {
-                            bonus += sequenciaAtual * sequenciaAtual * 5;
-                        }
-                        sequenciaAtual = 1;
-                    }
-                }
-                // Verificar última sequência
-                if (sequenciaAtual >= 2) {
-                    bonus += sequenciaAtual * sequenciaAtual * 5;
-                }
-            }
+    // Armazenar no cache
+    cacheCusto.inserir(hashSolucao, custo);
+
+    return custo;
+}
+
+// Penalidade 1: Distribuição desigual de aulas por dia
+double SimulatedAnnealing::calcularPenalidade1(const std::vector<AulaCompacta>& solucao) const {
+    return somaPenalidadeDistribuicao(contarAulasPorTurmaDia(solucao));
+}
+
+// Penalidade 2: Falta de aulas consecutivas (na verdade é bônus)
+double SimulatedAnnealing::calcularPenalidade2(const std::vector<AulaCompacta>& solucao) const {
+    int bonus = 0;
+
+    // Sequências de horas seguidas da mesma disciplina numa turma e dia
+    for (const auto& aulas : aulasPorGrupo) {
+        MascaraSlots mascara = 0;
+        for (int i : aulas) {
+            mascara |= InstanciaCompilada::bitSlot(solucao[i].slot);
         }
+        bonus += bonusConsecutivas(mascara);
     }
 
     return -bonus; // Retorna negativo porque é bônus
 }
 
+// Matriz dia x turma com o número de aulas da solução
+MatrizDias SimulatedAnnealing::contarAulasPorTurmaDia(const std::vector<AulaCompacta>& solucao) const {
+    MatrizDias matriz(instancia->numTurmas());
+    for (const auto& aula : solucao) {
+        matriz.adicionar(aula.turma, aula.dia());
+    }
+    return matriz;
+}
+
 // Penalidade 3: Janelas de horário dos professores
-double SimulatedAnnealing::calcularPenalidade3(const std::vector<Aula>& solucao) const {
+double SimulatedAnnealing::calcularPenalidade3(const std::vector<AulaCompacta>& solucao) const {
     double penalidade = 0.0;
 
-    auto janelasMap = obterJanelasPorProfessor(solucao);
-
-    for (const auto& [profId, janelas] : janelasMap) {
-        int totalJanelas = std::accumulate(janelas.begin(), janelas.end(), 0);
-
-        // Penalidade progressiva
-        if (totalJanelas <= 2) {
-            penalidade += totalJanelas * 5;
-        } else if (totalJanelas <= 5) {
-            penalidade += 10 + (totalJanelas - 2) * 10;
-        } else {
-            penalidade += 40 + (totalJanelas - 5) * 20;
-        }
-
-        // Penalizar janelas longas
-        for (int janela : janelas) {
-            if (janela >= 3) {
-                penalidade += janela * janela * 2;
-            }
-        }
+    for (MascaraSlots mascara : ocupacaoPorProfessor(solucao)) {
+        penalidade += penalidadeJanelas(mascara);
     }
 
     return penalidade;
 }
 
 // Penalidade 4: Horários extremos
-double SimulatedAnnealing::calcularPenalidade4(const std::vector<Aula>& solucao) const {
+double SimulatedAnnealing::calcularPenalidade4(const std::vector<AulaCompacta>& solucao) const {
     double penalidade = 0.0;
 
-    for (const auto& aula : solucao) {
-        if (aula.slot.isHorarioExtremo()) {
+    for (size_t i = 0; i < solucao.size(); i++) {
+        const auto& aula = solucao[i];
+        if (aula.getSlot().isHorarioExtremo()) {
             penalidade += 3;
 
             // Penalizar mais se for disciplina importante
-            auto it = std::find_if(disciplinas.begin(), disciplinas.end(),
-                [&](const Disciplina& d) { return d.id == aula.idDisciplina; });
-
-            if (it != disciplinas.end() && it->getCargaHorariaTotal() >= 20) {
+            if (instancia->cargaTotalDisciplina(solucao[i].disciplina) >= 20) {
                 penalidade += 2; // Disciplinas com muitas aulas devem evitar extremos
             }
         }
 
         // Penalizar aulas após intervalo longo (após 10:05)
-        if (aula.slot.hora >= 3) {
+        if (aula.hora() >= 3) {
             penalidade += 1;
         }
     }
@@ -371,284 +664,689 @@ double SimulatedAnnealing::calcularPenalidade4(const std::vector<Aula>& solucao)
 }
 
 // Penalidade 5: Preferências não atendidas
-double SimulatedAnnealing::calcularPenalidade5(const std::vector<Aula>& solucao) const {
+double SimulatedAnnealing::calcularPenalidade5(const std::vector<AulaCompacta>& solucao) const {
     double penalidade = 0.0;
 
     // Verificar preferências de horário das disciplinas
-    for (const auto& aula : solucao) {
-        auto it = std::find_if(disciplinas.begin(), disciplinas.end(),
-            [&](const Disciplina& d) { return d.id == aula.idDisciplina; });
-
-        if (it != disciplinas.end() && !it->horariosPreferidos.empty()) {
-            if (it->horariosPreferidos.find(aula.slot.hora) == it->horariosPreferidos.end()) {
+    for (size_t i = 0; i < solucao.size(); i++) {
+        int d = solucao[i].disciplina;
+        if (instancia->temHorariosPreferidos(d)) {
+            if (!((instancia->horariosPreferidos(d) >> solucao[i].hora()) & 1u)) {
                 penalidade += 5;
             }
         }
     }
 
     // Verificar turno das turmas
-    for (const auto& aula : solucao) {
-        auto turma = std::find_if(turmas.begin(), turmas.end(),
-            [&](const Turma& t) { return t.id == aula.idTurma; });
-
-        if (turma != turmas.end()) {
-            // Penalizar aulas fora do turno preferido
-            if (turma->turno == Turno::MANHA && aula.slot.hora >= 4) {
-                penalidade += 10;
-            } else if (turma->turno == Turno::TARDE && aula.slot.hora < 2) {
-                penalidade += 10;
-            }
+    for (size_t i = 0; i < solucao.size(); i++) {
+        Turno turno = instancia->turnoTurma(solucao[i].turma);
+        int hora = solucao[i].hora();
+
+        // Penalizar aulas fora do turno preferido
+        if (turno == Turno::MANHA && hora >= 4) {
+            penalidade += 10;
+        } else if (turno == Turno::TARDE && hora < 2) {
+            penalidade += 10;
         }
     }
 
     return penalidade;
 }
 
-// Obter janelas por professor
-std::map<int, std::vector<int>> SimulatedAnnealing::obterJanelasPorProfessor(
-    const std::vector<Aula>& solucao) const {
+// Combina as somas (sem peso) das penalidades no custo total
+double SimulatedAnnealing::combinarPenalidades(double distribuicao, double consecutivas,
+                                               double janelas, double extremos,
+                                               double preferencias) const {
+    double custo = 0.0;
+    custo += config.pesoDistribuicao * distribuicao;
+    custo += config.pesoConsecutivas * consecutivas;
+    custo += config.pesoJanelas * janelas;
+    custo += config.pesoHorariosExtremos * extremos;
+    custo += config.pesoPreferencias * preferencias;
+    return custo;
+}
+
+// Penalidade 1 de uma única turma
+double SimulatedAnnealing::contribuicaoDistribuicao(const std::vector<AulaCompacta>& solucao, int turma) const {
+    int aulasPorDia[NUM_DIAS] = {0, 0, 0, 0, 0};
+    for (int i : aulasPorTurma[turma]) {
+        aulasPorDia[solucao[i].dia()]++;
+    }
+    return penalidadeDistribuicaoLinha(aulasPorDia);
+}
+
+// Penalidade 2 de uma turma em um dia
+double SimulatedAnnealing::contribuicaoConsecutivas(const std::vector<AulaCompacta>& solucao,
+                                                    int turma, int dia) const {
+    int bonus = 0;
+    for (int g = primeiroGrupoTurma[turma]; g < primeiroGrupoTurma[turma + 1]; g++) {
+        MascaraSlots mascara = 0;
+        for (int i : aulasPorGrupo[g]) {
+            mascara |= InstanciaCompilada::bitSlot(solucao[i].slot);
+        }
+        bonus += bonusConsecutivasDia(mascara, dia);
+    }
+    return -bonus;
+}
+
+// Penalidade 3 de um único professor
+double SimulatedAnnealing::contribuicaoJanelas(const std::vector<AulaCompacta>& solucao, int professor) const {
+    MascaraSlots mascara = 0;
+    for (int i : aulasPorProfessor[professor]) {
+        mascara |= InstanciaCompilada::bitSlot(solucao[i].slot);
+    }
+    return penalidadeJanelas(mascara);
+}
 
-    std::map<int, std::vector<int>> janelas;
+// Penalidade 4 de uma aula em um slot
+double SimulatedAnnealing::penalidadeExtremosAula(int aula, const Slot& slot) const {
+    double penalidade = 0.0;
+    if (slot.isHorarioExtremo()) {
+        penalidade += 3;
+        if (instancia->cargaTotalDisciplina(solucaoAtual[aula].disciplina) >= 20) {
+            penalidade += 2;
+        }
+    }
+    if (slot.hora >= 3) {
+        penalidade += 1;
+    }
+    return penalidade;
+}
+
+// Penalidade 5 de uma aula em um slot
+double SimulatedAnnealing::penalidadePreferenciasAula(int aula, const Slot& slot) const {
+    double penalidade = 0.0;
+
+    int d = solucaoAtual[aula].disciplina;
+    if (instancia->temHorariosPreferidos(d) &&
+        !((instancia->horariosPreferidos(d) >> slot.hora) & 1u)) {
+        penalidade += 5;
+    }
+
+    Turno turno = instancia->turnoTurma(solucaoAtual[aula].turma);
+    if (turno == Turno::MANHA && slot.hora >= 4) {
+        penalidade += 10;
+    } else if (turno == Turno::TARDE && slot.hora < 2) {
+        penalidade += 10;
+    }
+
+    return penalidade;
+}
 
-    for (const auto& prof : professores) {
-        janelas[prof.id] = std::vector<int>();
+// Recalcula todas as contribuições em cache a partir de uma solução
+void SimulatedAnnealing::inicializarContribuicoes(const std::vector<AulaCompacta>& solucao) {
+    ContribuicoesCusto c;
 
+    c.distribuicaoTurma.resize(instancia->numTurmas());
+    c.consecutivasTurmaDia.resize(instancia->numTurmas() * 5);
+    for (int t = 0; t < instancia->numTurmas(); t++) {
+        c.distribuicaoTurma[t] = contribuicaoDistribuicao(solucao, t);
+        c.somaDistribuicao += c.distribuicaoTurma[t];
         for (int dia = 0; dia < 5; dia++) {
-            std::vector<int> horariosNoDia;
+            c.consecutivasTurmaDia[t * 5 + dia] = contribuicaoConsecutivas(solucao, t, dia);
+            c.somaConsecutivas += c.consecutivasTurmaDia[t * 5 + dia];
+        }
+    }
 
-            for (const auto& aula : solucao) {
-                if (aula.idProfessor == prof.id && aula.slot.dia == dia) {
-                    horariosNoDia.push_back(aula.slot.hora);
-                }
-            }
+    c.janelasProfessor.resize(instancia->numProfessores());
+    for (int p = 0; p < instancia->numProfessores(); p++) {
+        c.janelasProfessor[p] = contribuicaoJanelas(solucao, p);
+        c.somaJanelas += c.janelasProfessor[p];
+    }
 
-            if (horariosNoDia.size() > 1) {
-                std::sort(horariosNoDia.begin(), horariosNoDia.end());
+    for (size_t i = 0; i < solucao.size(); i++) {
+        c.somaExtremos += penalidadeExtremosAula(i, solucao[i].getSlot());
+        c.somaPreferencias += penalidadePreferenciasAula(i, solucao[i].getSlot());
+    }
 
-                for (size_t i = 1; i < horariosNoDia.size(); i++) {
-                    int janela = horariosNoDia[i] - horariosNoDia[i-1] - 1;
-                    if (janela > 0) {
-                        janelas[prof.id].push_back(janela);
-                    }
-                }
-            }
+    contribuicoes = std::move(c);
+}
+
+// Custo do vizinho recalculando apenas as turmas, dias e professores
+// das aulas alteradas pelo movimento
+double SimulatedAnnealing::calcularCustoIncremental(const Movimento& movimento) {
+    // O movimento já foi aplicado: a solução atual é o vizinho avaliado
+    const std::vector<AulaCompacta>& solucao = solucaoAtual;
+    AlteracaoContribuicoes& alt = alteracaoPendente;
+    alt = AlteracaoContribuicoes();
+
+    auto marcar = [](std::vector<std::pair<int, double>>& lista, int chave) {
+        for (const auto& [k, v] : lista) {
+            if (k == chave) return;
         }
+        lista.push_back({chave, 0.0});
+    };
+
+    for (const auto& alteracao : movimento.alteracoes) {
+        int i = alteracao.aula;
+        const Slot& antes = alteracao.anterior;
+        const Slot& depois = alteracao.novo;
+        if (antes == depois) continue;
+
+        alt.deltaExtremos += penalidadeExtremosAula(i, depois) - penalidadeExtremosAula(i, antes);
+        alt.deltaPreferencias += penalidadePreferenciasAula(i, depois) - penalidadePreferenciasAula(i, antes);
+
+        int t = solucao[i].turma;
+        marcar(alt.turmas, t);
+        marcar(alt.turmaDias, t * 5 + antes.dia);
+        marcar(alt.turmaDias, t * 5 + depois.dia);
+        marcar(alt.professores, solucao[i].professor);
+    }
+
+    for (auto& [t, valor] : alt.turmas) {
+        valor = contribuicaoDistribuicao(solucao, t);
+        alt.deltaDistribuicao += valor - contribuicoes.distribuicaoTurma[t];
+    }
+    for (auto& [chave, valor] : alt.turmaDias) {
+        valor = contribuicaoConsecutivas(solucao, chave / 5, chave % 5);
+        alt.deltaConsecutivas += valor - contribuicoes.consecutivasTurmaDia[chave];
+    }
+    // A ocupação dos professores já reflete o movimento aplicado
+    for (auto& [p, valor] : alt.professores) {
+        valor = penalidadeJanelas(ocupacaoProfessor[p]);
+        alt.deltaJanelas += valor - contribuicoes.janelasProfessor[p];
     }
 
-    return janelas;
+    double custo = combinarPenalidades(
+        contribuicoes.somaDistribuicao + alt.deltaDistribuicao,
+        contribuicoes.somaConsecutivas + alt.deltaConsecutivas,
+        contribuicoes.somaJanelas + alt.deltaJanelas,
+        contribuicoes.somaExtremos + alt.deltaExtremos,
+        contribuicoes.somaPreferencias + alt.deltaPreferencias);
+
+    // Modo de depuração: confere com o cálculo completo (sem passar pelo cache)
+    if (config.validarCustoIncremental) {
+        double custoCompleto = combinarPenalidades(
+            calcularPenalidade1(solucao), calcularPenalidade2(solucao),
+            calcularPenalidade3(solucao), calcularPenalidade4(solucao),
+            calcularPenalidade5(solucao));
+        if (std::abs(custoCompleto - custo) > 1e-6 * std::max(1.0, std::abs(custoCompleto))) {
+            std::cerr << "[SA] Custo incremental divergente: " << custo
+                      << " (completo: " << custoCompleto << ")" << std::endl;
+            alt.divergente = true;
+            return custoCompleto;
+        }
+        if (hashAtual != calcularHash(solucao)) {
+            std::cerr << "[SA] Hash incremental divergente" << std::endl;
+            hashAtual = calcularHash(solucao);
+        }
+    }
+
+    return custo;
+}
+
+// Aplica ao cache as contribuições do vizinho aceito
+void SimulatedAnnealing::confirmarCustoIncremental() {
+    const AlteracaoContribuicoes& alt = alteracaoPendente;
+
+    if (alt.divergente) {
+        inicializarContribuicoes(solucaoAtual);
+        return;
+    }
+
+    for (const auto& [t, valor] : alt.turmas) {
+        contribuicoes.distribuicaoTurma[t] = valor;
+    }
+    for (const auto& [chave, valor] : alt.turmaDias) {
+        contribuicoes.consecutivasTurmaDia[chave] = valor;
+    }
+    for (const auto& [p, valor] : alt.professores) {
+        contribuicoes.janelasProfessor[p] = valor;
+    }
+
+    contribuicoes.somaDistribuicao += alt.deltaDistribuicao;
+    contribuicoes.somaConsecutivas += alt.deltaConsecutivas;
+    contribuicoes.somaJanelas += alt.deltaJanelas;
+    contribuicoes.somaExtremos += alt.deltaExtremos;
+    contribuicoes.somaPreferencias += alt.deltaPreferencias;
+}
+
+// Máscara dos slots ocupados por cada professor (índice denso)
+std::vector<MascaraSlots> SimulatedAnnealing::ocupacaoPorProfessor(const std::vector<AulaCompacta>& solucao) const {
+    std::vector<MascaraSlots> ocupacao(instancia->numProfessores(), 0);
+    for (const auto& aula : solucao) {
+        ocupacao[aula.professor] |= InstanciaCompilada::bitSlot(aula.slot);
+    }
+    return ocupacao;
+}
+
+const char* nomeTipoMovimento(TipoMovimento tipo) {
+    switch (tipo) {
+        case TipoMovimento::TROCAR_HORARIO: return "trocarHorario";
+        case TipoMovimento::TROCAR_DIA: return "trocarDia";
+        case TipoMovimento::TROCAR_SLOT: return "trocarSlot";
+        case TipoMovimento::TROCAR_AULAS: return "trocarAulas";
+        case TipoMovimento::CADEIA_KEMPE: return "cadeiaKempe";
+        case TipoMovimento::MOVER_BLOCO: return "moverBloco";
+        case TipoMovimento::OTIMIZAR_PROFESSOR: return "otimizarProfessor";
+        case TipoMovimento::OTIMIZAR_TURMA: return "otimizarTurma";
+        case TipoMovimento::MOVER_GEMINADA: return "moverGeminada";
+    }
+    return "desconhecido";
+}
+
+const char* nomeCriterioParada(CriterioParada criterio) {
+    switch (criterio) {
+        case CriterioParada::ITERACOES: return "iteracoes";
+        case CriterioParada::PRAZO: return "prazo";
+        case CriterioParada::CONVERGENCIA: return "convergencia";
+        case CriterioParada::INTERROMPIDO: return "interrompido";
+    }
+    return "desconhecido";
 }
 
 // Seleção de movimento
 Movimento SimulatedAnnealing::selecionarMovimento() {
-    // Selecionar tipo de movimento com probabilidades ajustadas
-    int tipo = disMovimento(gen);
-
-    // Ajustar probabilidades baseado na temperatura
-    if (temperaturaAtual < config.temperaturaInicial * 0.3) {
-        // Em temperaturas baixas, preferir movimentos locais
-        if (tipo > 3) tipo = gen() % 4;
+    int tipo = 0;
+
+    if (config.selecaoAdaptativa) {
+        // Roleta sobre as probabilidades aprendidas
+        double sorteio = gen.real();
+        const auto& pesos = estatisticas.pesosMovimento;
+        size_t k = 0;
+        while (k + 1 < tiposAtivos.size() && sorteio >= pesos[tiposAtivos[k]]) {
+            sorteio -= pesos[tiposAtivos[k]];
+            k++;
+        }
+        tipo = tiposAtivos[k];
+    } else {
+        tipo = tiposAtivos[gen.inteiro(static_cast<uint32_t>(tiposAtivos.size()))];
+
+        // Em temperaturas baixas, preferir movimentos locais (até CADEIA_KEMPE,
+        // e o dos blocos geminados, que só eles movem)
+        if (temperaturaAtual < config.temperaturaInicial * 0.3) {
+            const int numLocais = static_cast<int>(TipoMovimento::CADEIA_KEMPE) + 1;
+            if (tipo >= numLocais && tipo != static_cast<int>(TipoMovimento::MOVER_GEMINADA)) {
+                // tiposAtivos em ordem: os locais ativos são um prefixo
+                auto locais = std::lower_bound(tiposAtivos.begin(), tiposAtivos.end(), numLocais) -
+                              tiposAtivos.begin();
+                if (locais > 0) tipo = tiposAtivos[gen.inteiro(static_cast<uint32_t>(locais))];
+            }
+        }
     }
 
     Movimento movimento(static_cast<TipoMovimento>(tipo));
+    sortearParametros(movimento);
+    return movimento;
+}
+
+// Perseguição adaptativa: a recompensa média do tipo proposto acompanha a
+// recompensa recebida; as probabilidades andam em direção a pMax para o tipo
+// de maior recompensa média e a pMin para os demais. pMin divide a fração
+// probabilidadeMinimaMovimento entre os tipos ativos. Sem nenhuma recompensa
+// ainda, a seleção continua uniforme.
+void SimulatedAnnealing::atualizarSelecaoAdaptativa(TipoMovimento tipo, double recompensa) {
+    double& media = recompensaMovimento[static_cast<int>(tipo)];
+    media += TAXA_RECOMPENSA * (recompensa - media);
+
+    int melhor = tiposAtivos[0];
+    for (int t : tiposAtivos) {
+        if (recompensaMovimento[t] > recompensaMovimento[melhor]) melhor = t;
+    }
+    if (recompensaMovimento[melhor] <= 0.0) return;
+
+    const double numTipos = static_cast<double>(tiposAtivos.size());
+    const double pMin = std::clamp(config.probabilidadeMinimaMovimento, 0.0, 1.0) / numTipos;
+    const double pMax = 1.0 - (numTipos - 1) * pMin;
+    auto& pesos = estatisticas.pesosMovimento;
+    for (int t : tiposAtivos) {
+        double alvo = t == melhor ? pMax : pMin;
+        pesos[t] += TAXA_PERSEGUICAO * (alvo - pesos[t]);
+    }
+}
+
+// Tira da seleção um tipo cujas propostas do aquecimento foram todas
+// inviáveis; a probabilidade dele é redistribuída entre os demais (o último
+// tipo ativo nunca sai)
+void SimulatedAnnealing::desativarTipoMovimento(TipoMovimento tipo) {
+    int t = static_cast<int>(tipo);
+    auto pos = std::find(tiposAtivos.begin(), tiposAtivos.end(), t);
+    if (pos == tiposAtivos.end() || tiposAtivos.size() == 1) return;
+    tiposAtivos.erase(pos);
+
+    auto& pesos = estatisticas.pesosMovimento;
+    pesos[t] = 0.0;
+    recompensaMovimento[t] = 0.0;
+    double soma = 0.0;
+    for (int u : tiposAtivos) soma += pesos[u];
+    for (int u : tiposAtivos) {
+        pesos[u] = soma > 0.0 ? pesos[u] / soma : 1.0 / tiposAtivos.size();
+    }
+}
+
+// Sorteia os parâmetros específicos do tipo do movimento
+void SimulatedAnnealing::sortearParametros(Movimento& movimento) {
+    if (solucaoAtual.empty()) return;
 
-    // Adicionar parâmetros específicos do movimento
     switch (movimento.tipo) {
         case TipoMovimento::TROCAR_HORARIO:
         case TipoMovimento::TROCAR_DIA:
         case TipoMovimento::TROCAR_SLOT:
-            movimento.parametros.push_back(gen() % solucaoAtual.size());
+        case TipoMovimento::TROCAR_AULAS:
+            movimento.parametros.push_back(sortearAulaAvulsa());
             break;
 
-        case TipoMovimento::TROCAR_AULAS:
-            movimento.parametros.push_back(gen() % solucaoAtual.size());
-            movimento.parametros.push_back(gen() % solucaoAtual.size());
+        case TipoMovimento::CADEIA_KEMPE: {
+            // Aula semente e um segundo slot, diferente do slot dela
+            int semente = sortearAulaAvulsa();
+            int outroSlot = gen.inteiro(NUM_SLOTS - 1);
+            if (outroSlot >= solucaoAtual[semente].slot) outroSlot++;
+            movimento.parametros.push_back(semente);
+            movimento.parametros.push_back(outroSlot);
             break;
+        }
 
         case TipoMovimento::MOVER_BLOCO:
-            movimento.parametros.push_back(gen() % turmas.size());
-            movimento.parametros.push_back(gen() % disciplinas.size());
+            movimento.parametros.push_back(gen.inteiro(instancia->numTurmas()));
+            movimento.parametros.push_back(gen.inteiro(instancia->numDisciplinas()));
             break;
 
         case TipoMovimento::OTIMIZAR_PROFESSOR:
-            movimento.parametros.push_back(gen() % professores.size());
+            movimento.parametros.push_back(gen.inteiro(instancia->numProfessores()));
             break;
 
         case TipoMovimento::OTIMIZAR_TURMA:
-            movimento.parametros.push_back(gen() % turmas.size());
+            movimento.parametros.push_back(gen.inteiro(instancia->numTurmas()));
             break;
+
+        case TipoMovimento::MOVER_GEMINADA:
+            if (!paresGeminados.empty()) {
+                movimento.parametros.push_back(gen.inteiro(static_cast<uint32_t>(paresGeminados.size())));
+            }
+            break;
+    }
+}
+
+// Aula sorteada entre as que não estão em bloco geminado (sem blocos, entre
+// todas), para os movimentos de uma aula
+int SimulatedAnnealing::sortearAulaAvulsa() {
+    if (paresGeminados.empty() || aulasAvulsas.empty()) {
+        return gen.inteiro(static_cast<uint32_t>(solucaoAtual.size()));
     }
+    return aulasAvulsas[gen.inteiro(static_cast<uint32_t>(aulasAvulsas.size()))];
+}
 
-    movimento.calcularHash();
-    return movimento;
+// Aulas do par geminado, a do horário mais cedo primeiro
+std::array<int, 2> SimulatedAnnealing::aulasDoBloco(int par) const {
+    auto [a, b] = paresGeminados[par];
+    return solucaoAtual[a].slot < solucaoAtual[b].slot ? std::array<int, 2>{a, b} : std::array<int, 2>{b, a};
 }
 
-// Verificar se movimento é tabu
+// Verificar se movimento é tabu: leva alguma aula (ou uma idêntica) de volta
+// a um slot que ela deixou recentemente
 bool SimulatedAnnealing::movimentoTabu(const Movimento& mov) const {
-    return std::find(listaTabu.begin(), listaTabu.end(), mov) != listaTabu.end();
+    for (const auto& alteracao : mov.alteracoes) {
+        if (contagemTabu[representanteAula[alteracao.aula] * NUM_SLOTS + alteracao.novo.getId()] > 0) {
+            return true;
+        }
+    }
+    return false;
 }
 
-// Adicionar movimento à lista tabu
+// Adicionar à memória tabu os slots deixados pelas aulas do movimento
 void SimulatedAnnealing::adicionarTabu(const Movimento& mov) {
-    listaTabu.push_back(mov);
-    if (listaTabu.size() > static_cast<size_t>(config.tamanhoListaTabu)) {
-        listaTabu.pop_front();
+    if (anelTabu.empty()) return;
+
+    for (const auto& alteracao : mov.alteracoes) {
+        int chave = representanteAula[alteracao.aula] * NUM_SLOTS + alteracao.anterior.getId();
+
+        // Anel cheio: o atributo mais antigo deixa de ser tabu
+        if (ocupacaoAnelTabu == anelTabu.size()) {
+            contagemTabu[anelTabu[posicaoAnelTabu]]--;
+        } else {
+            ocupacaoAnelTabu++;
+        }
+
+        anelTabu[posicaoAnelTabu] = chave;
+        contagemTabu[chave]++;
+        posicaoAnelTabu = (posicaoAnelTabu + 1) % anelTabu.size();
     }
 }
 
-// Gerar vizinho
-std::vector<Aula> SimulatedAnnealing::gerarVizinho(const std::vector<Aula>& solucao) {
-    Movimento movimento = selecionarMovimento();
+// Esvaziar a memória tabu
+void SimulatedAnnealing::limparTabu() {
+    std::fill(contagemTabu.begin(), contagemTabu.end(), 0);
+    posicaoAnelTabu = 0;
+    ocupacaoAnelTabu = 0;
+}
+
+// Gerar vizinho: preenche o registro de mudanças do movimento selecionado,
+// usando os parâmetros sorteados em selecionarMovimento()
+void SimulatedAnnealing::gerarVizinho(Movimento& movimento) {
+    movimento.alteracoes.clear();
+    if (movimento.parametros.empty()) return;
 
     switch (movimento.tipo) {
         case TipoMovimento::TROCAR_HORARIO:
-            return trocarHorario(solucao);
+            trocarHorario(movimento);
+            break;
         case TipoMovimento::TROCAR_DIA:
-            return trocarDia(solucao);
+            trocarDia(movimento);
+            break;
         case TipoMovimento::TROCAR_SLOT:
-            return trocarSlot(solucao);
+            trocarSlot(movimento);
+            break;
         case TipoMovimento::TROCAR_AULAS:
-            return trocarAulas(solucao);
+            trocarAulas(movimento);
+            break;
+        case TipoMovimento::CADEIA_KEMPE:
+            cadeiaKempe(movimento);
+            break;
         case TipoMovimento::MOVER_BLOCO:
-            return moverBloco(solucao);
+            moverBloco(movimento);
+            break;
         case TipoMovimento::OTIMIZAR_PROFESSOR:
-            return otimizarProfessor(solucao);
+            otimizarProfessor(movimento);
+            break;
         case TipoMovimento::OTIMIZAR_TURMA:
-            return otimizarTurma(solucao);
-        default:
-            return solucao;
+            otimizarTurma(movimento);
+            break;
+        case TipoMovimento::MOVER_GEMINADA:
+            moverGeminada(movimento);
+            break;
     }
 }
 
-// Implementação dos movimentos
-std::vector<Aula> SimulatedAnnealing::trocarHorario(const std::vector<Aula>& solucao) {
-    if (solucao.empty()) return solucao;
-
-    std::vector<Aula> nova = solucao;
-    std::uniform_int_distribution<> distAula(0, nova.size() - 1);
-    std::uniform_int_distribution<> distHora(0, 5);
-
-    int idx = distAula(gen);
-    int novoHorario = distHora(gen);
-
-    // Tentar mudar apenas o horário
-    Slot novoSlot = nova[idx].slot;
-    novoSlot.hora = novoHorario;
-    nova[idx].slot = novoSlot;
+// Slots para onde a aula pode ir sem conflito: professor disponível e livre,
+// turma livre e sala exclusiva livre (o slot atual da aula nunca está livre)
+MascaraSlots SimulatedAnnealing::slotsLivres(int aula) const {
+    const auto& a = solucaoAtual[aula];
+    MascaraSlots livres = instancia->disponibilidadeProfessor(a.professor) &
+                          ~ocupacaoProfessor[a.professor] & ~ocupacaoTurma[a.turma];
+    if (a.sala >= 0 && !instancia->salaCompartilhada(a.sala)) {
+        livres &= ~ocupacaoSala[a.sala];
+    }
+    return livres;
+}
 
-    return nova;
+// Troca de slots entre duas aulas da mesma turma sem conflito: cada
+// professor disponível no slot da outra e livre nele (a não ser pela própria
+// outra aula), e o mesmo para as salas exclusivas
+bool SimulatedAnnealing::trocaViavel(int a, int b) const {
+    const auto& x = solucaoAtual[a];
+    const auto& y = solucaoAtual[b];
+    MascaraSlots bitX = InstanciaCompilada::bitSlot(x.slot);
+    MascaraSlots bitY = InstanciaCompilada::bitSlot(y.slot);
+
+    auto salaLivre = [&](int sala, int outraSala, MascaraSlots bit) {
+        return sala < 0 || sala == outraSala || instancia->salaCompartilhada(sala) ||
+               !(ocupacaoSala[sala] & bit);
+    };
+    return instancia->professorDisponivel(x.professor, y.slot) &&
+           instancia->professorDisponivel(y.professor, x.slot) &&
+           (x.professor == y.professor ||
+            (!(ocupacaoProfessor[x.professor] & bitY) && !(ocupacaoProfessor[y.professor] & bitX))) &&
+           salaLivre(x.sala, y.sala, bitY) && salaLivre(y.sala, x.sala, bitX);
 }
 
-std::vector<Aula> SimulatedAnnealing::trocarDia(const std::vector<Aula>& solucao) {
-    if (solucao.empty()) return solucao;
+// Move a aula para um slot livre sorteado entre os `destinos`. Sem nenhum
+// livre, recorre a trocarNaTurma
+void SimulatedAnnealing::realocarOuTrocar(Movimento& movimento, MascaraSlots destinos) {
+    int idx = movimento.parametros[0];
+    const auto& aula = solucaoAtual[idx];
 
-    std::vector<Aula> nova = solucao;
-    std::uniform_int_distribution<> distAula(0, nova.size() - 1);
-    std::uniform_int_distribution<> distDia(0, 4);
+    MascaraSlots livres = slotsLivres(idx) & destinos;
+    if (livres) {
+        Slot novoSlot = Slot::fromId(sortearBit(livres, gen));
+        movimento.alteracoes.push_back({idx, aula.getSlot(), novoSlot});
+        return;
+    }
+    trocarNaTurma(movimento, destinos);
+}
 
-    int idx = distAula(gen);
-    int novoDia = distDia(gen);
+// Troca a aula com outra da mesma turma, sorteada entre as que estão num dos
+// `destinos` (fora do slot dela), fora de bloco geminado, não idênticas a ela
+// e cuja troca é viável
+void SimulatedAnnealing::trocarNaTurma(Movimento& movimento, MascaraSlots destinos) {
+    int idx = movimento.parametros[0];
+    const auto& aula = solucaoAtual[idx];
+
+    destinos &= ~InstanciaCompilada::bitSlot(aula.slot);
+    auto candidata = [&](int j) {
+        return ((destinos >> solucaoAtual[j].slot) & 1u) && parceiroGeminada[j] < 0 &&
+               !aulasIdenticas(idx, j) && trocaViavel(idx, j);
+    };
+    int candidatas = 0;
+    for (int j : aulasPorTurma[aula.turma]) {
+        candidatas += candidata(j);
+    }
+    if (candidatas == 0) return;
+
+    int escolhida = static_cast<int>(gen.inteiro(candidatas));
+    for (int j : aulasPorTurma[aula.turma]) {
+        if (candidata(j) && escolhida-- == 0) {
+            movimento.alteracoes.push_back({idx, aula.getSlot(), solucaoAtual[j].getSlot()});
+            movimento.alteracoes.push_back({j, solucaoAtual[j].getSlot(), aula.getSlot()});
+            return;
+        }
+    }
+}
 
-    // Tentar mudar apenas o dia
-    Slot novoSlot = nova[idx].slot;
-    novoSlot.dia = novoDia;
-    nova[idx].slot = novoSlot;
+// Implementação dos movimentos
+void SimulatedAnnealing::trocarHorario(Movimento& movimento) {
+    if (solucaoAtual.empty()) return;
 
-    return nova;
+    // Mudar apenas o horário
+    int dia = solucaoAtual[movimento.parametros[0]].dia();
+    realocarOuTrocar(movimento, MASCARA_DIA << (dia * NUM_HORARIOS));
 }
 
-std::vector<Aula> SimulatedAnnealing::trocarSlot(const std::vector<Aula>& solucao) {
-    if (solucao.empty()) return solucao;
+void SimulatedAnnealing::trocarDia(Movimento& movimento) {
+    if (solucaoAtual.empty()) return;
 
-    std::vector<Aula> nova = solucao;
-    std::uniform_int_distribution<> distAula(0, nova.size() - 1);
-    std::uniform_int_distribution<> distDia(0, 4);
-    std::uniform_int_distribution<> distHora(0, 5);
+    // Mudar apenas o dia
+    int hora = solucaoAtual[movimento.parametros[0]].hora();
+    realocarOuTrocar(movimento, MASCARA_HORA << hora);
+}
 
-    int idx = distAula(gen);
+void SimulatedAnnealing::trocarSlot(Movimento& movimento) {
+    if (solucaoAtual.empty()) return;
 
     // Mudar dia e horário
-    Slot novoSlot(distDia(gen), distHora(gen));
-    nova[idx].slot = novoSlot;
-
-    return nova;
+    realocarOuTrocar(movimento, MASCARA_SEMANA);
 }
 
-std::vector<Aula> SimulatedAnnealing::trocarAulas(const std::vector<Aula>& solucao) {
-    if (solucao.size() < 2) return solucao;
+void SimulatedAnnealing::trocarAulas(Movimento& movimento) {
+    if (solucaoAtual.size() < 2) return;
 
-    std::vector<Aula> nova = solucao;
-    std::uniform_int_distribution<> distAula(0, nova.size() - 1);
+    // Parceira da mesma turma em qualquer outro slot
+    trocarNaTurma(movimento, MASCARA_SEMANA);
+}
 
-    int idx1 = distAula(gen);
-    int idx2 = distAula(gen);
+// Cadeia de Kempe entre o slot da aula semente e um segundo slot: o
+// componente conexo, entre as aulas desses dois slots, ligado por professor,
+// turma ou sala exclusiva em comum. Trocar o componente inteiro de slot não
+// cria conflitos; resta apenas conferir a disponibilidade dos professores.
+void SimulatedAnnealing::cadeiaKempe(Movimento& movimento) {
+    if (solucaoAtual.empty()) return;
+
+    int semente = movimento.parametros[0];
+    int slotA = solucaoAtual[semente].slot;
+    int slotB = movimento.parametros[1];
+    if (slotA == slotB) return;
+
+    std::vector<int> cadeia{semente};
+    for (size_t i = 0; i < cadeia.size(); i++) {
+        const auto& aula = solucaoAtual[cadeia[i]];
+        int outroSlot = aula.slot == slotA ? slotB : slotA;
+
+        auto visitar = [&](const std::vector<int>& aulas) {
+            for (int j : aulas) {
+                if (solucaoAtual[j].slot == outroSlot &&
+                    std::find(cadeia.begin(), cadeia.end(), j) == cadeia.end()) {
+                    cadeia.push_back(j);
+                }
+            }
+        };
+        visitar(aulasPorProfessor[aula.professor]);
+        visitar(aulasPorTurma[aula.turma]);
+        if (aula.sala >= 0 && !instancia->salaCompartilhada(aula.sala)) {
+            visitar(aulasPorSala[aula.sala]);
+        }
+    }
 
-    if (idx1 != idx2) {
-        // Trocar os slots das duas aulas
-        std::swap(nova[idx1].slot, nova[idx2].slot);
+    // Um par de aulas idênticas, uma em cada slot, trocaria de lugar sem
+    // efeito: fica fora do movimento
+    std::vector<bool> fixa(cadeia.size(), false);
+    for (size_t i = 0; i < cadeia.size(); i++) {
+        if (fixa[i] || solucaoAtual[cadeia[i]].slot != slotA) continue;
+        for (size_t k = 0; k < cadeia.size(); k++) {
+            if (!fixa[k] && solucaoAtual[cadeia[k]].slot == slotB && aulasIdenticas(cadeia[i], cadeia[k])) {
+                fixa[i] = fixa[k] = true;
+                break;
+            }
+        }
     }
 
-    return nova;
+    for (size_t i = 0; i < cadeia.size(); i++) {
+        if (fixa[i]) continue;
+        int j = cadeia[i];
+        int novoSlot = solucaoAtual[j].slot == slotA ? slotB : slotA;
+        movimento.alteracoes.push_back({j, solucaoAtual[j].getSlot(), Slot::fromId(novoSlot)});
+    }
 }
 
-std::vector<Aula> SimulatedAnnealing::moverBloco(const std::vector<Aula>& solucao) {
-    if (solucao.empty()) return solucao;
-
-    std::vector<Aula> nova = solucao;
+void SimulatedAnnealing::moverBloco(Movimento& movimento) {
+    if (solucaoAtual.empty()) return;
 
-    // Selecionar turma e disciplina aleatórias
-    std::uniform_int_distribution<> distTurma(0, turmas.size() - 1);
-    std::uniform_int_distribution<> distDisc(0, disciplinas.size() - 1);
-
-    int idTurma = turmas[distTurma(gen)].id;
-    int idDisciplina = disciplinas[distDisc(gen)].id;
+    // Turma e disciplina sorteadas em selecionarMovimento()
+    int turma = movimento.parametros[0];
+    int disciplina = movimento.parametros[1];
 
     // Encontrar aulas da turma/disciplina
-    std::vector<size_t> indices;
-    for (size_t i = 0; i < nova.size(); i++) {
-        if (nova[i].idTurma == idTurma && nova[i].idDisciplina == idDisciplina) {
+    std::vector<int> indices;
+    for (int i : aulasPorTurma[turma]) {
+        if (solucaoAtual[i].disciplina == disciplina) {
             indices.push_back(i);
         }
     }
 
-    if (indices.size() >= 2) {
+    if (indices.size() >= 2 && indices.size() <= NUM_HORARIOS) {
         // Tentar mover para horários consecutivos
-        std::uniform_int_distribution<> distDia(0, 4);
-        std::uniform_int_distribution<> distHoraInicio(0, 6 - indices.size());
-
-        int novoDia = distDia(gen);
-        int horaInicio = distHoraInicio(gen);
+        int novoDia = gen.inteiro(NUM_DIAS);
+        int horaInicio = gen.intervalo(0, NUM_HORARIOS - static_cast<int>(indices.size()));
 
         for (size_t i = 0; i < indices.size(); i++) {
-            nova[indices[i]].slot.dia = novoDia;
-            nova[indices[i]].slot.hora = horaInicio + i;
+            Slot novoSlot(novoDia, horaInicio + i);
+            if (solucaoAtual[indices[i]].getSlot() == novoSlot) continue;
+            movimento.alteracoes.push_back({indices[i], solucaoAtual[indices[i]].getSlot(), novoSlot});
         }
     }
-
-    return nova;
 }
 
-std::vector<Aula> SimulatedAnnealing::otimizarProfessor(const std::vector<Aula>& solucao) {
-    if (solucao.empty() || professores.empty()) return solucao;
-
-    std::vector<Aula> nova = solucao;
-    std::uniform_int_distribution<> distProf(0, professores.size() - 1);
-
-    int idProfessor = professores[distProf(gen)].id;
+void SimulatedAnnealing::otimizarProfessor(Movimento& movimento) {
+    if (solucaoAtual.empty() || instancia->numProfessores() == 0) return;
 
-    // Coletar aulas do professor
-    std::vector<size_t> indicesProf;
-    for (size_t i = 0; i < nova.size(); i++) {
-        if (nova[i].idProfessor == idProfessor) {
-            indicesProf.push_back(i);
-        }
-    }
+    int professor = movimento.parametros[0];
 
-    if (indicesProf.size() < 2) return nova;
+    // Aulas do professor
+    const std::vector<int>& indicesProf = aulasPorProfessor[professor];
+    if (indicesProf.size() < 2) return;
 
     // Tentar compactar horário do professor
-    std::map<int, std::vector<size_t>> aulasPorDia;
-    for (size_t idx : indicesProf) {
-        aulasPorDia[nova[idx].slot.dia].push_back(idx);
+    std::map<int, std::vector<int>> aulasPorDia;
+    for (int idx : indicesProf) {
+        aulasPorDia[solucaoAtual[idx].dia()].push_back(idx);
     }
 
     // Para cada dia com aulas, tentar compactar
@@ -657,159 +1355,271 @@ std::vector<Aula> SimulatedAnnealing::otimizarProfessor(const std::vector<Aula>&
 
         // Ordenar por horário
         std::sort(indices.begin(), indices.end(),
-            [&](size_t a, size_t b) {
-                return nova[a].slot.hora < nova[b].slot.hora;
+            [&](int a, int b) {
+                return solucaoAtual[a].hora() < solucaoAtual[b].hora();
             });
 
         // Compactar removendo janelas
-        int horaAtual = nova[indices[0]].slot.hora;
+        int horaAtual = solucaoAtual[indices[0]].hora();
         for (size_t i = 1; i < indices.size(); i++) {
-            if (nova[indices[i]].slot.hora > horaAtual + 1) {
-                nova[indices[i]].slot.hora = horaAtual + 1;
+            Slot slotAula = solucaoAtual[indices[i]].getSlot();
+            if (slotAula.hora > horaAtual + 1) {
+                Slot novoSlot(dia, horaAtual + 1);
+                movimento.alteracoes.push_back({indices[i], slotAula, novoSlot});
+                horaAtual = novoSlot.hora;
+            } else {
+                horaAtual = slotAula.hora;
             }
-            horaAtual = nova[indices[i]].slot.hora;
         }
     }
-
-    return nova;
 }
 
-std::vector<Aula> SimulatedAnnealing::otimizarTurma(const std::vector<Aula>& solucao) {
-    if (solucao.empty() || turmas.empty()) return solucao;
+void SimulatedAnnealing::otimizarTurma(Movimento& movimento) {
+    if (solucaoAtual.empty() || instancia->numTurmas() == 0) return;
 
-    std::vector<Aula> nova = solucao;
-    std::uniform_int_distribution<> distTurma(0, turmas.size() - 1);
-
-    int idTurma = turmas[distTurma(gen)].id;
+    int turma = movimento.parametros[0];
 
     // Implementação similar à otimização de professor, mas para turma
     // ... (código similar ao otimizarProfessor mas para turma)
+}
+
+// Move o bloco geminado para um início sorteado entre os que têm os dois
+// slots livres (os do próprio bloco contam como livres). Sem nenhum, troca
+// com outro bloco da mesma turma cujas duas trocas de aula são viáveis.
+void SimulatedAnnealing::moverGeminada(Movimento& movimento) {
+    auto [primeira, segunda] = aulasDoBloco(movimento.parametros[0]);
+    const auto& aula = solucaoAtual[primeira];
+    MascaraSlots bitInicio = InstanciaCompilada::bitSlot(aula.slot);
+
+    MascaraSlots inicios = iniciosGeminada(slotsLivres(primeira) | slotsGeminada(bitInicio)) & ~bitInicio;
+    if (inicios) {
+        int novoInicio = sortearBit(inicios, gen);
+        movimento.alteracoes.push_back({primeira, aula.getSlot(), Slot::fromId(novoInicio)});
+        movimento.alteracoes.push_back({segunda, solucaoAtual[segunda].getSlot(), Slot::fromId(novoInicio + 1)});
+        return;
+    }
+
+    auto candidato = [&](int par) {
+        auto [outraPrimeira, outraSegunda] = aulasDoBloco(par);
+        return !aulasIdenticas(primeira, outraPrimeira) &&
+               trocaViavel(primeira, outraPrimeira) && trocaViavel(segunda, outraSegunda);
+    };
+    const auto& pares = paresGeminadosPorTurma[aula.turma];
+    int candidatos = 0;
+    for (int par : pares) {
+        candidatos += candidato(par);
+    }
+    if (candidatos == 0) return;
+
+    int escolhido = static_cast<int>(gen.inteiro(candidatos));
+    for (int par : pares) {
+        if (candidato(par) && escolhido-- == 0) {
+            auto [outraPrimeira, outraSegunda] = aulasDoBloco(par);
+            movimento.alteracoes.push_back({primeira, aula.getSlot(), solucaoAtual[outraPrimeira].getSlot()});
+            movimento.alteracoes.push_back({segunda, solucaoAtual[segunda].getSlot(), solucaoAtual[outraSegunda].getSlot()});
+            movimento.alteracoes.push_back({outraPrimeira, solucaoAtual[outraPrimeira].getSlot(), aula.getSlot()});
+            movimento.alteracoes.push_back({outraSegunda, solucaoAtual[outraSegunda].getSlot(), solucaoAtual[segunda].getSlot()});
+            return;
+        }
+    }
+}
+
+// Aplica o movimento na solução atual, guardando os slots anteriores
+// para desfazerMovimento()
+void SimulatedAnnealing::aplicarMovimento(const Movimento& movimento) {
+    registroDesfazer.clear();
+
+    // Libera tudo antes de ocupar, para trocas entre as próprias aulas do movimento
+    for (const auto& alteracao : movimento.alteracoes) {
+        registroDesfazer.push_back({alteracao.aula, solucaoAtual[alteracao.aula].getSlot()});
+        liberarSlot(alteracao.aula, solucaoAtual[alteracao.aula].getSlot());
+        hashAtual ^= valorZobrist(alteracao.aula, solucaoAtual[alteracao.aula].getSlot());
+    }
+    for (const auto& alteracao : movimento.alteracoes) {
+        solucaoAtual[alteracao.aula].setSlot(alteracao.novo);
+        ocuparSlot(alteracao.aula, alteracao.novo);
+        hashAtual ^= valorZobrist(alteracao.aula, alteracao.novo);
+    }
+}
+
+// Restaura os slots guardados pelo último aplicarMovimento()
+void SimulatedAnnealing::desfazerMovimento() {
+    for (const auto& [aula, anterior] : registroDesfazer) {
+        liberarSlot(aula, solucaoAtual[aula].getSlot());
+        hashAtual ^= valorZobrist(aula, solucaoAtual[aula].getSlot());
+    }
+    for (auto it = registroDesfazer.rbegin(); it != registroDesfazer.rend(); ++it) {
+        solucaoAtual[it->first].setSlot(it->second);
+        ocuparSlot(it->first, it->second);
+        hashAtual ^= valorZobrist(it->first, it->second);
+    }
+    registroDesfazer.clear();
+}
+
+void SimulatedAnnealing::ocuparSlot(int aula, const Slot& slot) {
+    const auto& idx = solucaoAtual[aula];
+    MascaraSlots bit = InstanciaCompilada::bitSlot(InstanciaCompilada::slotId(slot.dia, slot.hora));
+    ocupacaoProfessor[idx.professor] |= bit;
+    ocupacaoTurma[idx.turma] |= bit;
+    if (idx.sala >= 0 && !instancia->salaCompartilhada(idx.sala)) {
+        ocupacaoSala[idx.sala] |= bit;
+    }
+}
+
+void SimulatedAnnealing::liberarSlot(int aula, const Slot& slot) {
+    const auto& idx = solucaoAtual[aula];
+    MascaraSlots bit = InstanciaCompilada::bitSlot(InstanciaCompilada::slotId(slot.dia, slot.hora));
+    ocupacaoProfessor[idx.professor] &= ~bit;
+    ocupacaoTurma[idx.turma] &= ~bit;
+    if (idx.sala >= 0 && !instancia->salaCompartilhada(idx.sala)) {
+        ocupacaoSala[idx.sala] &= ~bit;
+    }
+}
 
-    return nova;
+// Recalcula a ocupação a partir da solução atual
+void SimulatedAnnealing::reconstruirOcupacao() {
+    ocupacaoProfessor.assign(instancia->numProfessores(), 0);
+    ocupacaoTurma.assign(instancia->numTurmas(), 0);
+    ocupacaoSala.assign(instancia->numSalas(), 0);
+
+    for (size_t i = 0; i < solucaoAtual.size(); i++) {
+        ocuparSlot(i, solucaoAtual[i].getSlot());
+    }
 }
 
 // Verificação de viabilidade completa
-bool SimulatedAnnealing::verificarViabilidade(const std::vector<Aula>& solucao) {
-    // Verificar conflitos de professor
-    std::map<std::tuple<int, int, int>, int> ocupacaoProfessor;
+bool SimulatedAnnealing::verificarViabilidade(const std::vector<AulaCompacta>& solucao) {
+    // Ocupação por entidade como máscara de slots
+    std::vector<MascaraSlots> ocupacaoProfessor(instancia->numProfessores(), 0);
+    std::vector<MascaraSlots> ocupacaoTurma(instancia->numTurmas(), 0);
+    std::vector<MascaraSlots> ocupacaoSala(instancia->numSalas(), 0);
+
+    for (size_t i = 0; i < solucao.size(); i++) {
+        const auto& idx = solucao[i];
+        int slotId = InstanciaCompilada::slotId(solucao[i].dia(), solucao[i].hora());
+        MascaraSlots bit = InstanciaCompilada::bitSlot(slotId);
 
-    for (const auto& aula : solucao) {
         // Verificar disponibilidade do professor
-        if (disponibilidadeProfessores.find({aula.idProfessor, aula.slot.dia, aula.slot.hora}) ==
-            disponibilidadeProfessores.end()) {
+        if (!instancia->professorDisponivel(idx.professor, slotId)) {
             return false;
         }
 
-        // Verificar conflitos
-        auto chave = std::make_tuple(aula.idProfessor, aula.slot.dia, aula.slot.hora);
-        ocupacaoProfessor[chave]++;
-        if (ocupacaoProfessor[chave] > 1) {
+        // Verificar conflitos de professor
+        if (ocupacaoProfessor[idx.professor] & bit) {
             return false;
         }
-    }
+        ocupacaoProfessor[idx.professor] |= bit;
 
-    // Verificar conflitos de turma
-    std::map<std::tuple<int, int, int>, int> ocupacaoTurma;
-    for (const auto& aula : solucao) {
-        auto chave = std::make_tuple(aula.idTurma, aula.slot.dia, aula.slot.hora);
-        ocupacaoTurma[chave]++;
-        if (ocupacaoTurma[chave] > 1) {
+        // Verificar conflitos de turma
+        if (ocupacaoTurma[idx.turma] & bit) {
             return false;
         }
-    }
+        ocupacaoTurma[idx.turma] |= bit;
 
-    // Verificar conflitos de sala
-    std::map<std::tuple<int, int, int>, std::vector<int>> ocupacaoSala;
-    for (const auto& aula : solucao) {
-        auto chave = std::make_tuple(aula.idSala, aula.slot.dia, aula.slot.hora);
-        ocupacaoSala[chave].push_back(aula.idTurma);
-
-        // Verificar se é sala compartilhada
-        auto sala = std::find_if(salas.begin(), salas.end(),
-            [&](const Sala& s) { return s.id == aula.idSala; });
-
-        if (sala != salas.end() && !sala->compartilhada && ocupacaoSala[chave].size() > 1) {
-            return false;
+        // Verificar conflitos de sala (salas compartilhadas aceitam várias turmas)
+        if (idx.sala >= 0 && !instancia->salaCompartilhada(idx.sala)) {
+            if (ocupacaoSala[idx.sala] & bit) {
+                return false;
+            }
+            ocupacaoSala[idx.sala] |= bit;
         }
     }
 
     return true;
 }
 
-// Verificação de viabilidade rápida (incremental)
-bool SimulatedAnnealing::verificarViabilidadeRapida(const std::vector<Aula>& solucao,
-                                                   const Movimento& movimento) {
-    // Implementação otimizada que verifica apenas as mudanças
-    // causadas pelo movimento específico
+// Verificação de viabilidade rápida (incremental): confere apenas os novos
+// slots das aulas do movimento contra a ocupação da solução atual
+bool SimulatedAnnealing::verificarViabilidadeRapida(const Movimento& movimento) {
+    // Retirar temporariamente as aulas movidas da ocupação
+    for (const auto& alteracao : movimento.alteracoes) {
+        liberarSlot(alteracao.aula, alteracao.anterior);
+    }
 
-    switch (movimento.tipo) {
-        case TipoMovimento::TROCAR_HORARIO:
-        case TipoMovimento::TROCAR_DIA:
-        case TipoMovimento::TROCAR_SLOT: {
-            if (movimento.parametros.empty()) return false;
-            int idx = movimento.parametros[0];
-            if (idx >= static_cast<int>(solucao.size())) return false;
+    bool viavel = true;
+    size_t ocupadas = 0;
+    for (const auto& alteracao : movimento.alteracoes) {
+        const auto& idx = solucaoAtual[alteracao.aula];
+        int slotId = InstanciaCompilada::slotId(alteracao.novo.dia, alteracao.novo.hora);
+        MascaraSlots bit = InstanciaCompilada::bitSlot(slotId);
+
+        bool salaExclusiva = idx.sala >= 0 && !instancia->salaCompartilhada(idx.sala);
+        if (!instancia->professorDisponivel(idx.professor, slotId) ||
+            (ocupacaoProfessor[idx.professor] & bit) ||
+            (ocupacaoTurma[idx.turma] & bit) ||
+            (salaExclusiva && (ocupacaoSala[idx.sala] & bit))) {
+            viavel = false;
+            break;
+        }
 
-            const auto& aula = solucao[idx];
+        // Ocupar para detectar conflitos entre as próprias aulas do movimento
+        ocuparSlot(alteracao.aula, alteracao.novo);
+        ocupadas++;
+    }
 
-            // Verificar disponibilidade do professor
-            if (disponibilidadeProfessores.find({aula.idProfessor, aula.slot.dia, aula.slot.hora}) ==
-                disponibilidadeProfessores.end()) {
-                return false;
-            }
+    // Restaurar a ocupação
+    for (size_t i = 0; i < ocupadas; i++) {
+        liberarSlot(movimento.alteracoes[i].aula, movimento.alteracoes[i].novo);
+    }
+    for (const auto& alteracao : movimento.alteracoes) {
+        ocuparSlot(alteracao.aula, alteracao.anterior);
+    }
 
-            // Verificar conflitos no novo slot
-            for (size_t i = 0; i < solucao.size(); i++) {
-                if (i == static_cast<size_t>(idx)) continue;
+    return viavel;
+}
 
-                const auto& outraAula = solucao[i];
-                if (outraAula.slot.dia == aula.slot.dia &&
-                    outraAula.slot.hora == aula.slot.hora) {
+// Cada aula de bloco geminado movida continua em slot seguido ao do
+// parceiro, no mesmo dia (o parceiro no seu novo slot, se também movido)
+bool SimulatedAnnealing::preservaGeminadas(const Movimento& movimento) const {
+    for (const auto& alteracao : movimento.alteracoes) {
+        int parceiro = parceiroGeminada[alteracao.aula];
+        if (parceiro < 0) continue;
 
-                    if (outraAula.idProfessor == aula.idProfessor ||
-                        outraAula.idTurma == aula.idTurma ||
-                        outraAula.idSala == aula.idSala) {
-                        return false;
-                    }
-                }
-            }
-            break;
+        int slotParceiro = solucaoAtual[parceiro].slot;
+        for (const auto& outra : movimento.alteracoes) {
+            if (outra.aula == parceiro) slotParceiro = outra.novo.getId();
         }
-
-        case TipoMovimento::TROCAR_AULAS: {
-            if (movimento.parametros.size() < 2) return false;
-            // Verificar viabilidade das duas trocas
-            // ... implementação específica
-            break;
+        if (!iniciosGeminada(InstanciaCompilada::bitSlot(alteracao.novo.getId()) |
+                             InstanciaCompilada::bitSlot(slotParceiro))) {
+            return false;
         }
-
-        default:
-            // Para movimentos complexos, fazer verificação completa
-            return verificarViabilidade(solucao);
     }
+    return true;
+}
 
+// Todos os pares geminados da solução em slots seguidos do mesmo dia
+bool SimulatedAnnealing::geminadasIntactas(const std::vector<AulaCompacta>& solucao) const {
+    for (const auto& [a, b] : paresGeminados) {
+        if (!iniciosGeminada(InstanciaCompilada::bitSlot(solucao[a].slot) |
+                             InstanciaCompilada::bitSlot(solucao[b].slot))) {
+            return false;
+        }
+    }
     return true;
 }
 
 // Validação completa da solução
-ResultadoValidacao SimulatedAnnealing::validarSolucaoCompleta(const std::vector<Aula>& solucao) {
+ResultadoValidacao SimulatedAnnealing::validarSolucaoCompleta(const std::vector<AulaCompacta>& solucao) {
     ResultadoValidacao resultado;
 
     // Verificar conflitos básicos
     if (!verificarViabilidade(solucao)) {
         resultado.adicionarErro("Solução contém conflitos de horário");
     }
+    if (!geminadasIntactas(solucao)) {
+        resultado.adicionarErro("Solução separa aulas geminadas");
+    }
 
     // Verificar completude
     std::map<std::tuple<int, int, int>, int> aulasEsperadas;
     std::map<std::tuple<int, int, int>, int> aulasReais;
 
     // Contar aulas esperadas
-    for (const auto& disc : disciplinas) {
+    for (const auto& disc : instancia->getDisciplinas()) {
         for (const auto& [turmaId, qtd] : disc.aulasPorTurma) {
             // Assumir que cada disciplina tem um professor
             int profId = 0;
-            for (const auto& prof : professores) {
+            for (const auto& prof : instancia->getProfessores()) {
                 // Encontrar professor da disciplina
                 // ... lógica para mapear professor-disciplina
             }
@@ -819,7 +1629,9 @@ ResultadoValidacao SimulatedAnnealing::validarSolucaoCompleta(const std::vector<
 
     // Contar aulas reais
     for (const auto& aula : solucao) {
-        aulasReais[{aula.idTurma, aula.idDisciplina, aula.idProfessor}]++;
+        aulasReais[{instancia->turma(aula.turma).id,
+                    instancia->disciplina(aula.disciplina).id,
+                    instancia->professor(aula.professor).id}]++;
     }
 
     // Comparar
@@ -835,10 +1647,8 @@ ResultadoValidacao SimulatedAnnealing::validarSolucaoCompleta(const std::vector<
     resultado.estatisticas["totalAulas"] = solucao.size();
     resultado.estatisticas["janelasTotal"] = 0;
 
-    auto janelasMap = obterJanelasPorProfessor(solucao);
-    for (const auto& [profId, janelas] : janelasMap) {
-        resultado.estatisticas["janelasTotal"] +=
-            std::accumulate(janelas.begin(), janelas.end(), 0);
+    for (MascaraSlots mascara : ocupacaoPorProfessor(solucao)) {
+        resultado.estatisticas["janelasTotal"] += totalJanelas(mascara);
     }
 
     return resultado;
@@ -852,7 +1662,7 @@ bool SimulatedAnnealing::aceitarMovimento(double deltaCusto) {
 
     // Probabilidade de aceitar piora
     double probabilidade = std::exp(-deltaCusto / temperaturaAtual);
-    return dis(gen) < probabilidade;
+    return gen.real() < probabilidade;
 }
 
 // Atualizar temperatura
@@ -903,66 +1713,283 @@ void SimulatedAnnealing::reaquecerTemperatura() {
     log("Reaquecimento aplicado. Nova temperatura: " + std::to_string(temperaturaAtual));
 
     // Limpar lista tabu para permitir exploração
-    listaTabu.clear();
+    limparTabu();
 }
 
-// Busca local 2-opt
-std::vector<Aula> SimulatedAnnealing::buscaLocal2opt(const std::vector<Aula>& solucao) {
-    std::vector<Aula> melhorLocal = solucao;
-    double melhorCustoLocal = calcularCusto(melhorLocal);
-    bool melhorou = true;
+// Polimento da solução atual até não haver troca ou realocação que melhore.
+// Cada varredura divide as aulas, a partir de `origem`, em blocos avaliados
+// em paralelo; a redução fica com o menor delta (empates: o bloco anterior),
+// então o resultado não depende do número de threads. Na primeira melhoria,
+// os blocos são curtos, a varredura para no primeiro lote com melhoria e a
+// seguinte começa logo após a aula movida. As threads são criadas uma vez por
+// polimento e recebem cada lote por uma barreira; entre o fim de um lote e o
+// início do próximo só a thread principal mexe na solução. Devolve os
+// movimentos aplicados.
+int SimulatedAnnealing::polirSolucaoAtual() {
+    const int n = static_cast<int>(solucaoAtual.size());
+    if (n == 0) return 0;
+
+    const bool primeiraMelhoria = !config.polimentoMelhorMelhoria;
+    const int numThreads = std::min(getNumThreadsPolimento(), std::max(n / AULAS_MINIMAS_POR_THREAD, 1));
+    const int tamanhoBloco = primeiraMelhoria ? std::min(BLOCO_PRIMEIRA_MELHORIA, n)
+                                              : (n + numThreads - 1) / numThreads;
+    std::vector<CandidatoPolimento> resultados(numThreads);
+    int origem = 0;
+    int aplicados = 0;
+
+    // Lote em varredura (-1 encerra as threads auxiliares)
+    int lote = 0;
+    Barreira barreira(numThreads);
+    auto varrerBloco = [&](int t) {
+        int inicio = std::min(lote + t * tamanhoBloco, n);
+        int fim = std::min(inicio + tamanhoBloco, n);
+        resultados[t] = varrerPolimento(origem, inicio, fim, primeiraMelhoria);
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; t++) {
+        threads.emplace_back([&, t] {
+            while (true) {
+                barreira.aguardar(); // Início do lote
+                if (lote < 0) return;
+                varrerBloco(t);
+                barreira.aguardar(); // Fim do lote
+            }
+        });
+    }
 
-    while (melhorou) {
-        melhorou = false;
+    while (true) {
+        // Com o prazo esgotado, para após o primeiro movimento aplicado
+        if (aplicados > 0 && config.prazo.esgotado()) break;
 
-        // Tentar todas as trocas de pares
-        for (size_t i = 0; i < melhorLocal.size() - 1; i++) {
-            for (size_t j = i + 1; j < melhorLocal.size(); j++) {
-                // Criar solução com troca
-                std::vector<Aula> vizinho = melhorLocal;
-                std::swap(vizinho[i].slot, vizinho[j].slot);
+        CandidatoPolimento escolhido;
+        for (lote = 0; lote < n && escolhido.aula < 0; lote += tamanhoBloco * numThreads) {
+            barreira.aguardar();
+            varrerBloco(0);
+            barreira.aguardar();
 
-                // Verificar viabilidade
-                if (!verificarViabilidade(vizinho)) continue;
+            for (const auto& candidato : resultados) {
+                if (candidato.aula >= 0 && (escolhido.aula < 0 || candidato.delta < escolhido.delta)) {
+                    escolhido = candidato;
+                    if (primeiraMelhoria) break;
+                }
+            }
+        }
+        if (escolhido.aula < 0) break;
+
+        Movimento movimento(escolhido.outra >= 0 ? TipoMovimento::TROCAR_AULAS : TipoMovimento::TROCAR_SLOT);
+        movimento.alteracoes.push_back({escolhido.aula, solucaoAtual[escolhido.aula].getSlot(),
+                                        Slot::fromId(escolhido.slot)});
+        if (escolhido.outra >= 0) {
+            movimento.alteracoes.push_back({escolhido.outra, solucaoAtual[escolhido.outra].getSlot(),
+                                            solucaoAtual[escolhido.aula].getSlot()});
+        }
 
-                // Calcular custo
-                double custoVizinho = calcularCusto(vizinho);
+        aplicarMovimento(movimento);
+        double custo = calcularCustoIncremental(movimento);
+        if (custo >= estatisticas.custoFinal) {
+            desfazerMovimento(); // Delta estimado sem melhoria real: encerra
+            break;
+        }
+        confirmarCustoIncremental();
+        registroDesfazer.clear();
+        estatisticas.custoFinal = custo;
+        aplicados++;
 
-                if (custoVizinho < melhorCustoLocal) {
-                    melhorLocal = vizinho;
-                    melhorCustoLocal = custoVizinho;
-                    melhorou = true;
-                    break;
-                }
+        if (primeiraMelhoria) {
+            origem = (escolhido.aula + 1) % n;
+        }
+    }
+
+    lote = -1;
+    barreira.aguardar();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return aplicados;
+}
+
+// Melhor candidato (ou o primeiro que melhora) das aulas nas posições
+// [inicio, fim) da varredura que começa na aula `origem`. Só lê o estado.
+SimulatedAnnealing::CandidatoPolimento SimulatedAnnealing::varrerPolimento(
+    int origem, int inicio, int fim, bool primeiraMelhoria) const {
+    const int n = static_cast<int>(solucaoAtual.size());
+    CandidatoPolimento melhor;
+
+    // Verdadeiro quando a varredura pode parar
+    auto considerar = [&](int aula, int outra, int slot) {
+        double delta = 0.0;
+        if (!avaliarCandidatoPolimento(aula, outra, slot, delta) ||
+            delta >= -LIMIAR_MELHORIA_POLIMENTO || (melhor.aula >= 0 && delta >= melhor.delta)) {
+            return false;
+        }
+        melhor.delta = delta;
+        melhor.aula = aula;
+        melhor.outra = outra;
+        melhor.slot = slot;
+        return primeiraMelhoria;
+    };
+
+    for (int posicao = inicio; posicao < fim; posicao++) {
+        int a = (origem + posicao) % n;
+        const auto& aula = solucaoAtual[a];
+
+        // Blocos geminados só mudam de lugar pelo movimento próprio
+        if (parceiroGeminada[a] >= 0) continue;
+
+        // Trocas com aulas da mesma turma ou do mesmo professor (cada par uma
+        // vez, sem pares de aulas idênticas)
+        for (int b : aulasPorTurma[aula.turma]) {
+            if (b > a && solucaoAtual[b].slot != aula.slot && parceiroGeminada[b] < 0 && !aulasIdenticas(a, b) &&
+                considerar(a, b, solucaoAtual[b].slot)) {
+                return melhor;
+            }
+        }
+        for (int b : aulasPorProfessor[aula.professor]) {
+            if (b > a && solucaoAtual[b].turma != aula.turma && parceiroGeminada[b] < 0 &&
+                solucaoAtual[b].slot != aula.slot && considerar(a, b, solucaoAtual[b].slot)) {
+                return melhor;
+            }
+        }
+
+        // Realocações para slots livres para o professor, a turma e a sala
+        MascaraSlots livres = slotsLivres(a);
+        while (livres) {
+            int slot = __builtin_ctz(livres);
+            livres &= livres - 1;
+            if (considerar(a, -1, slot)) {
+                return melhor;
             }
-            if (melhorou) break;
         }
     }
 
-    return melhorLocal;
+    return melhor;
+}
+
+// Delta do custo ao mover `aula` para `slot` e, numa troca, `outra` para o
+// slot atual de `aula`, a partir da ocupação e das contribuições da solução
+// atual (sem alterá-las). Falso se o vizinho é inviável.
+bool SimulatedAnnealing::avaliarCandidatoPolimento(int aula, int outra, int slot, double& delta) const {
+    // Ocupação, depois do movimento, de cada entidade tocada (até duas)
+    struct Tocadas {
+        int ids[2];
+        MascaraSlots mascaras[2];
+        int n = 0;
+
+        MascaraSlots& mascara(int id, const std::vector<MascaraSlots>& ocupacao) {
+            for (int k = 0; k < n; k++) {
+                if (ids[k] == id) return mascaras[k];
+            }
+            ids[n] = id;
+            mascaras[n] = ocupacao[id];
+            return mascaras[n++];
+        }
+    };
+    Tocadas professores, turmas, salas;
+
+    const int aulas[2] = {aula, outra};
+    const int destinos[2] = {slot, solucaoAtual[aula].slot};
+    const int numAulas = outra >= 0 ? 2 : 1;
+
+    auto salaExclusiva = [&](int sala) { return sala >= 0 && !instancia->salaCompartilhada(sala); };
+
+    for (int k = 0; k < numAulas; k++) {
+        const auto& a = solucaoAtual[aulas[k]];
+        MascaraSlots bit = InstanciaCompilada::bitSlot(a.slot);
+        professores.mascara(a.professor, ocupacaoProfessor) &= ~bit;
+        turmas.mascara(a.turma, ocupacaoTurma) &= ~bit;
+        if (salaExclusiva(a.sala)) salas.mascara(a.sala, ocupacaoSala) &= ~bit;
+    }
+    for (int k = 0; k < numAulas; k++) {
+        const auto& a = solucaoAtual[aulas[k]];
+        MascaraSlots bit = InstanciaCompilada::bitSlot(destinos[k]);
+        if (!instancia->professorDisponivel(a.professor, destinos[k])) return false;
+
+        MascaraSlots& professor = professores.mascara(a.professor, ocupacaoProfessor);
+        MascaraSlots& turma = turmas.mascara(a.turma, ocupacaoTurma);
+        if ((professor & bit) || (turma & bit)) return false;
+        professor |= bit;
+        turma |= bit;
+        if (salaExclusiva(a.sala)) {
+            MascaraSlots& sala = salas.mascara(a.sala, ocupacaoSala);
+            if (sala & bit) return false;
+            sala |= bit;
+        }
+    }
+
+    double deltaDistribuicao = 0.0, deltaConsecutivas = 0.0, deltaJanelas = 0.0;
+    double deltaExtremos = 0.0, deltaPreferencias = 0.0;
+
+    for (int k = 0; k < professores.n; k++) {
+        deltaJanelas += penalidadeJanelas(professores.mascaras[k]) -
+                        contribuicoes.janelasProfessor[professores.ids[k]];
+    }
+    for (int k = 0; k < turmas.n; k++) {
+        int aulasPorDia[NUM_DIAS];
+        for (int dia = 0; dia < NUM_DIAS; dia++) {
+            aulasPorDia[dia] = __builtin_popcount((turmas.mascaras[k] >> (dia * NUM_HORARIOS)) &
+                                                  ((1u << NUM_HORARIOS) - 1));
+        }
+        deltaDistribuicao += penalidadeDistribuicaoLinha(aulasPorDia) -
+                             contribuicoes.distribuicaoTurma[turmas.ids[k]];
+    }
+
+    // Consecutivas: só mudam os grupos (turma, disciplina) das aulas movidas
+    for (int k = 0; k < numAulas; k++) {
+        int g = grupoDaAula[aulas[k]];
+        if (k == 1 && g == grupoDaAula[aula]) break;
+        MascaraSlots antes = 0, depois = 0;
+        for (int i : aulasPorGrupo[g]) {
+            int slotAntes = solucaoAtual[i].slot;
+            antes |= InstanciaCompilada::bitSlot(slotAntes);
+            depois |= InstanciaCompilada::bitSlot(i == aula ? destinos[0] : i == outra ? destinos[1] : slotAntes);
+        }
+        deltaConsecutivas -= bonusConsecutivas(depois) - bonusConsecutivas(antes);
+    }
+
+    for (int k = 0; k < numAulas; k++) {
+        Slot antes = solucaoAtual[aulas[k]].getSlot();
+        Slot depois = Slot::fromId(destinos[k]);
+        deltaExtremos += penalidadeExtremosAula(aulas[k], depois) - penalidadeExtremosAula(aulas[k], antes);
+        deltaPreferencias += penalidadePreferenciasAula(aulas[k], depois) -
+                             penalidadePreferenciasAula(aulas[k], antes);
+    }
+
+    delta = combinarPenalidades(deltaDistribuicao, deltaConsecutivas, deltaJanelas,
+                                deltaExtremos, deltaPreferencias);
+    return true;
+}
+
+int SimulatedAnnealing::getNumThreadsPolimento() const {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return 1; // WebAssembly sem suporte a threads
+#else
+    int n = config.threadsPolimento;
+    if (n <= 0) {
+        n = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    return std::max(n, 1);
+#endif
 }
 
 // Busca local focada em reduzir janelas
-std::vector<Aula> SimulatedAnnealing::buscaLocalJanelas(const std::vector<Aula>& solucao) {
-    std::vector<Aula> melhorLocal = solucao;
+std::vector<AulaCompacta> SimulatedAnnealing::buscaLocalJanelas(const std::vector<AulaCompacta>& solucao) {
+    std::vector<AulaCompacta> melhorLocal = solucao;
     double melhorCustoLocal = calcularCusto(melhorLocal);
 
     // Para cada professor com janelas
-    auto janelasMap = obterJanelasPorProfessor(melhorLocal);
+    std::vector<MascaraSlots> ocupacao = ocupacaoPorProfessor(melhorLocal);
 
-    for (const auto& [profId, janelas] : janelasMap) {
-        if (janelas.empty()) continue;
+    for (int p = 0; p < instancia->numProfessores(); p++) {
+        if (totalJanelas(ocupacao[p]) == 0) continue;
 
         // Tentar compactar horário do professor
-        std::vector<Aula> tentativa = melhorLocal;
+        std::vector<AulaCompacta> tentativa = melhorLocal;
         bool modificou = false;
 
         // Coletar aulas do professor por dia
         std::map<int, std::vector<size_t>> aulasPorDia;
-        for (size_t i = 0; i < tentativa.size(); i++) {
-            if (tentativa[i].idProfessor == profId) {
-                aulasPorDia[tentativa[i].slot.dia].push_back(i);
-            }
+        for (int i : aulasPorProfessor[p]) {
+            aulasPorDia[tentativa[i].dia()].push_back(i);
         }
 
         // Compactar cada dia
@@ -972,23 +1999,23 @@ std::vector<Aula> SimulatedAnnealing::buscaLocalJanelas(const std::vector<Aula>&
             // Ordenar por horário
             std::sort(indices.begin(), indices.end(),
                 [&](size_t a, size_t b) {
-                    return tentativa[a].slot.hora < tentativa[b].slot.hora;
+                    return tentativa[a].hora() < tentativa[b].hora();
                 });
 
             // Tentar eliminar janelas
             for (size_t i = 1; i < indices.size(); i++) {
-                int horaAnterior = tentativa[indices[i-1]].slot.hora;
-                int horaAtual = tentativa[indices[i]].slot.hora;
+                int horaAnterior = tentativa[indices[i-1]].hora();
+                int horaAtual = tentativa[indices[i]].hora();
 
                 if (horaAtual > horaAnterior + 1) {
                     // Há janela, tentar mover
-                    tentativa[indices[i]].slot.hora = horaAnterior + 1;
+                    tentativa[indices[i]].setSlot(Slot(dia, horaAnterior + 1));
                     modificou = true;
                 }
             }
         }
 
-        if (modificou && verificarViabilidade(tentativa)) {
+        if (modificou && verificarViabilidade(tentativa) && geminadasIntactas(tentativa)) {
             double custoTentativa = calcularCusto(tentativa);
             if (custoTentativa < melhorCustoLocal) {
                 melhorLocal = tentativa;
@@ -1010,6 +2037,24 @@ void SimulatedAnnealing::registrarEstatistica(int iteracao) {
     }
 }
 
+// Tabela da telemetria por tipo de movimento
+void mostrarTelemetriaMovimentos(const EstatisticasSA& estatisticas) {
+    std::cout << "\nMovimento          | Propostos | Inviáveis |  Tabu | Aceitos | Melhorias | Delta médio | ns/movimento | Peso" << std::endl;
+    for (int t = 0; t < NUM_TIPOS_MOVIMENTO; t++) {
+        const auto& m = estatisticas.porMovimento[t];
+        double nsPorMovimento = m.propostos > 0 ? (double)(m.nsGeracao + m.nsAvaliacao) / m.propostos : 0.0;
+        std::cout << std::left << std::setw(18) << nomeTipoMovimento(static_cast<TipoMovimento>(t)) << std::right
+                  << " | " << std::setw(9) << m.propostos
+                  << " | " << std::setw(9) << m.rejeitadosInviaveis
+                  << " | " << std::setw(5) << m.rejeitadosTabu
+                  << " | " << std::setw(7) << m.aceitos
+                  << " | " << std::setw(9) << m.melhorias
+                  << " | " << std::setw(11) << m.getDeltaMedio()
+                  << " | " << std::setw(12) << nsPorMovimento
+                  << " | " << std::setw(5) << estatisticas.pesosMovimento[t] * 100 << "%" << std::endl;
+    }
+}
+
 // Mostrar estatísticas finais
 void SimulatedAnnealing::mostrarEstatisticas() const {
     std::cout << "\n=== ESTATÍSTICAS DO SIMULATED ANNEALING ===" << std::endl;
@@ -1021,7 +2066,11 @@ void SimulatedAnnealing::mostrarEstatisticas() const {
     std::cout << "Movimentos de melhoria: " << estatisticas.movimentosMelhoria << std::endl;
     std::cout << "Movimentos de piora aceitos: " << estatisticas.movimentosPiora << std::endl;
     std::cout << "Reaquecimentos: " << estatisticas.reaquecimentos << std::endl;
+    std::cout << "Iterações: " << estatisticas.iteracoesExecutadas
+              << " (parada: " << nomeCriterioParada(estatisticas.criterioParada) << ")" << std::endl;
     std::cout << "Melhor custo encontrado na iteração: " << estatisticas.iteracaoMelhorCusto << std::endl;
+    std::cout << "Cache de custo: " << cacheCusto.getAcertos() << "/" << cacheCusto.getConsultas()
+              << " acertos (" << cacheCusto.getCapacidade() << " entradas)" << std::endl;
 
     // Decomposição do custo final
     std::cout << "\nDecomposição do custo final (" << melhorCusto << "):" << std::endl;
@@ -1032,6 +2081,8 @@ void SimulatedAnnealing::mostrarEstatisticas() const {
     std::cout << "  Horários extremos: " << config.pesoHorariosExtremos * calcularPenalidade4(melhorSolucao) << std::endl;
     std::cout << "  Preferências: " << config.pesoPreferencias * calcularPenalidade5(melhorSolucao) << std::endl;
 
+    mostrarTelemetriaMovimentos(estatisticas);
+
     // Qualidade da solução
     auto qualidade = analisarQualidadeSolucao();
     std::cout << "\nQualidade da solução:" << std::endl;
@@ -1045,47 +2096,28 @@ std::map<std::string, double> SimulatedAnnealing::analisarQualidadeSolucao() con
     std::map<std::string, double> metricas;
 
     // Total de janelas
-    auto janelasMap = obterJanelasPorProfessor(melhorSolucao);
-    int totalJanelas = 0;
+    int janelasTotais = 0;
     int maxJanelasPorProf = 0;
 
-    for (const auto& [profId, janelas] : janelasMap) {
-        int janelasProfessor = std::accumulate(janelas.begin(), janelas.end(), 0);
-        totalJanelas += janelasProfessor;
+    for (MascaraSlots mascara : ocupacaoPorProfessor(melhorSolucao)) {
+        int janelasProfessor = totalJanelas(mascara);
+        janelasTotais += janelasProfessor;
         maxJanelasPorProf = std::max(maxJanelasPorProf, janelasProfessor);
     }
 
-    metricas["Janelas totais"] = totalJanelas;
+    metricas["Janelas totais"] = janelasTotais;
     metricas["Máx. janelas por professor"] = maxJanelasPorProf;
 
     // Aulas consecutivas
     metricas["Aulas consecutivas"] = contarAulasConsecutivasTotal(melhorSolucao);
 
     // Distribuição
-    double desvioTotal = 0;
-    for (const auto& turma : turmas) {
-        std::map<int, int> aulasPorDia;
-        int totalAulas = 0;
-
-        for (const auto& aula : melhorSolucao) {
-            if (aula.idTurma == turma.id) {
-                aulasPorDia[aula.slot.dia]++;
-                totalAulas++;
-            }
-        }
-
-        if (totalAulas > 0) {
-            double media = totalAulas / 5.0;
-            for (int dia = 0; dia < 5; dia++) {
-                desvioTotal += std::abs(aulasPorDia[dia] - media);
-            }
-        }
-    }
+    double desvioTotal = somaDesvioDistribuicao(contarAulasPorTurmaDia(melhorSolucao));
 
     metricas["Desvio de distribuição"] = desvioTotal;
 
     // Taxa de ocupação
-    metricas["Taxa de ocupação"] = (melhorSolucao.size() * 100.0) / (turmas.size() * 30);
+    metricas["Taxa de ocupação"] = (melhorSolucao.size() * 100.0) / (instancia->numTurmas() * 30);
 
     return metricas;
 }
@@ -1109,6 +2141,38 @@ void SimulatedAnnealing::exportarHistorico(const std::string& arquivo) const {
 
     out.close();
     log("Histórico exportado para: " + arquivo);
+
+    // Telemetria por tipo de movimento em um CSV ao lado do histórico
+    std::string arquivoMovimentos = arquivo;
+    size_t ponto = arquivoMovimentos.rfind('.');
+    if (ponto != std::string::npos && arquivoMovimentos.find('/', ponto) == std::string::npos) {
+        arquivoMovimentos.erase(ponto);
+    }
+    arquivoMovimentos += "_movimentos.csv";
+
+    std::ofstream outMovimentos(arquivoMovimentos);
+    if (!outMovimentos.is_open()) {
+        log("Erro ao criar arquivo de movimentos: " + arquivoMovimentos);
+        return;
+    }
+
+    outMovimentos << "TipoMovimento,Propostos,RejeitadosInviaveis,RejeitadosTabu,Aceitos,Melhorias,"
+                     "DeltaMedio,NsGeracao,NsAvaliacao,Peso\n";
+    for (int t = 0; t < NUM_TIPOS_MOVIMENTO; t++) {
+        const auto& m = estatisticas.porMovimento[t];
+        outMovimentos << nomeTipoMovimento(static_cast<TipoMovimento>(t)) << ","
+                      << m.propostos << ","
+                      << m.rejeitadosInviaveis << ","
+                      << m.rejeitadosTabu << ","
+                      << m.aceitos << ","
+                      << m.melhorias << ","
+                      << m.getDeltaMedio() << ","
+                      << m.nsGeracao << ","
+                      << m.nsAvaliacao << ","
+                      << estatisticas.pesosMovimento[t] << "\n";
+    }
+
+    log("Telemetria de movimentos exportada para: " + arquivoMovimentos);
 }
 
 // Ajustar pesos dinamicamente
@@ -1119,7 +2183,7 @@ void SimulatedAnnealing::ajustarPesos(double dist, double consec, double jan, do
     config.pesoHorariosExtremos = ext;
 
     // Limpar cache de custo pois os pesos mudaram
-    cacheCusto.clear();
+    cacheCusto.limpar();
 
     log("Pesos ajustados: Dist=" + std::to_string(dist) +
         ", Consec=" + std::to_string(consec) +
@@ -1128,31 +2192,15 @@ void SimulatedAnnealing::ajustarPesos(double dist, double consec, double jan, do
 }
 
 // Contar total de aulas consecutivas
-int SimulatedAnnealing::contarAulasConsecutivasTotal(const std::vector<Aula>& solucao) const {
+int SimulatedAnnealing::contarAulasConsecutivasTotal(const std::vector<AulaCompacta>& solucao) const {
     int total = 0;
 
-    for (const auto& turma : turmas) {
-        for (int dia = 0; dia < 5; dia++) {
-            std::map<int, std::vector<int>> aulasPorDisciplina;
-
-            for (const auto& aula : solucao) {
-                if (aula.idTurma == turma.id && aula.slot.dia == dia) {
-                    aulasPorDisciplina[aula.idDisciplina].push_back(aula.slot.hora);
-                }
-            }
-
-            for (auto& [discId, horarios] : aulasPorDisciplina) {
-                if (horarios.size() < 2) continue;
-
-                std::sort(horarios.begin(), horarios.end());
-
-                for (size_t i = 1; i < horarios.size(); i++) {
-                    if (horarios[i] == horarios[i-1] + 1) {
-                        total++;
-                    }
-                }
-            }
+    for (const auto& aulas : aulasPorGrupo) {
+        MascaraSlots mascara = 0;
+        for (int i : aulas) {
+            mascara |= InstanciaCompilada::bitSlot(solucao[i].slot);
         }
+        total += paresConsecutivos(mascara);
     }
 
     return total;
@@ -1160,6 +2208,6 @@ int SimulatedAnnealing::contarAulasConsecutivasTotal(const std::vector<Aula>& so
 
 // Limpar caches
 void SimulatedAnnealing::limparCaches() {
-    cacheCusto.clear();
+    cacheCusto.limpar();
     cacheHorariosProfessor.clear();
 }
\ No newline at end of file
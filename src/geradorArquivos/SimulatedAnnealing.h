@@ -1,13 +1,18 @@
 #pragma once
 #include "Estruturas.h"
+#include "InstanciaCompilada.h"
+#include "CacheCusto.h"
+#include "Aleatorio.h"
+#include "KernelsPenalidade.h"
+#include "Prazo.h"
 #include <vector>
+#include <array>
 #include <map>
 #include <set>
 #include <tuple>
 #include <random>
 #include <functional>
 #include <memory>
-#include <deque>
 
 // Estrutura para configurações do Simulated Annealing
 struct ConfiguracaoSA {
@@ -27,11 +32,22 @@ struct ConfiguracaoSA {
     // Estratégias
     bool usarReaquecimento;      // Reaquece quando estagnar
     bool usarMemoriaTabu;        // Evita movimentos recentes
-    int tamanhoListaTabu;        // Tamanho da lista tabu
+    bool selecaoAdaptativa;      // Tipos de movimento por perseguição adaptativa (senão, uniforme)
+    double probabilidadeMinimaMovimento; // Fração da seleção adaptativa reservada como piso, dividida entre os tipos ativos
+    int tamanhoListaTabu;        // Atributos (aula, slot) mantidos na memória tabu
+    int capacidadeCacheCusto;    // Entradas do cache de custo (potência de dois)
+    bool polimentoMelhorMelhoria; // Polimento final: melhor vizinho de cada varredura (senão, o primeiro que melhora)
+    int threadsPolimento;        // Threads da varredura do polimento (0 = todos os núcleos)
+
+    // Parada
+    Prazo prazo;                 // Instante limite (compartilhável com a Fase 1); padrão ilimitado
+    int janelaConvergencia;      // Para após tantas iterações sem novo melhor custo (0 = desligado)
 
     // Controle
     bool verboso;                // Exibir progresso detalhado
     int frequenciaRelatorio;     // A cada quantas iterações mostrar status
+    bool validarCustoIncremental; // Depuração: confere o custo incremental com o completo
+    uint64_t semente;            // 0 = não determinística
 
     // Construtor com valores padrão
     ConfiguracaoSA()
@@ -46,9 +62,86 @@ struct ConfiguracaoSA {
           pesoPreferencias(1.5),
           usarReaquecimento(true),
           usarMemoriaTabu(true),
+          selecaoAdaptativa(true),
+          probabilidadeMinimaMovimento(0.05),
           tamanhoListaTabu(50),
+          capacidadeCacheCusto(4096),
+          polimentoMelhorMelhoria(true),
+          threadsPolimento(0),
+          janelaConvergencia(0),
           verboso(false),
-          frequenciaRelatorio(1000) {}
+          frequenciaRelatorio(1000),
+          validarCustoIncremental(false),
+          semente(0) {}
+};
+
+// Tipos de movimentos possíveis
+enum class TipoMovimento {
+    TROCAR_HORARIO,      // Troca horário mantendo dia
+    TROCAR_DIA,          // Troca dia mantendo horário
+    TROCAR_SLOT,         // Troca dia e horário
+    TROCAR_AULAS,        // Troca duas aulas da mesma turma de lugar
+    CADEIA_KEMPE,        // Troca de slot uma cadeia de aulas em conflito entre dois slots
+    MOVER_BLOCO,         // Move bloco de aulas consecutivas
+    OTIMIZAR_PROFESSOR,  // Otimiza horário de um professor
+    OTIMIZAR_TURMA,      // Otimiza horário de uma turma
+    MOVER_GEMINADA       // Move ou troca um bloco de aulas geminadas (só com blocos)
+};
+
+constexpr int NUM_TIPOS_MOVIMENTO = 9;
+
+// Nome do tipo em camelCase ("trocarHorario"), usado nos relatórios e exportações
+const char* nomeTipoMovimento(TipoMovimento tipo);
+
+// Motivo do fim da fase de iterações do SA
+enum class CriterioParada {
+    ITERACOES,     // numIteracoes (ou rodadas) esgotadas
+    PRAZO,         // Prazo da configuração esgotado
+    CONVERGENCIA,  // janelaConvergencia iterações sem novo melhor custo
+    INTERROMPIDO   // pararExecucao()
+};
+
+// Nome do critério em camelCase ("convergencia"), usado nos relatórios e exportações
+const char* nomeCriterioParada(CriterioParada criterio);
+
+// Telemetria de um tipo de movimento
+struct EstatisticasMovimento {
+    long long propostos = 0;
+    long long rejeitadosInviaveis = 0; // Reprovados na viabilidade rápida
+    long long rejeitadosTabu = 0;
+    long long aceitos = 0;
+    long long melhorias = 0;           // Aceitos com delta negativo
+    long long avaliados = 0;           // Viáveis, com custo calculado
+    double somaDelta = 0.0;            // Soma dos deltas dos avaliados
+    long long nsGeracao = 0;           // Sorteio e geração do vizinho
+    long long nsAvaliacao = 0;         // Viabilidade, aplicação, custo e decisão
+
+    double getDeltaMedio() const { return avaliados > 0 ? somaDelta / avaliados : 0.0; }
+    double getTaxaAceitacao() const { return propostos > 0 ? (double)aceitos / propostos * 100 : 0; }
+
+    void acumular(const EstatisticasMovimento& outro) {
+        propostos += outro.propostos;
+        rejeitadosInviaveis += outro.rejeitadosInviaveis;
+        rejeitadosTabu += outro.rejeitadosTabu;
+        aceitos += outro.aceitos;
+        melhorias += outro.melhorias;
+        avaliados += outro.avaliados;
+        somaDelta += outro.somaDelta;
+        nsGeracao += outro.nsGeracao;
+        nsAvaliacao += outro.nsAvaliacao;
+    }
+};
+
+// Resumo de uma ilha do modelo de ilhas (ModeloIlhas)
+struct EstatisticasIlha {
+    int movimentosAceitos = 0;
+    int movimentosRejeitados = 0;
+    int reaquecimentos = 0;
+    int migracoesRecebidas = 0;
+    int migracoesAdotadas = 0;
+    double custoFinal = 0.0;      // Segundo os pesos da própria ilha
+    double custoReferencia = 0.0; // Segundo os pesos de referência
+    double tempoExecucao = 0.0;
 };
 
 // Estrutura para estatísticas do SA
@@ -59,6 +152,7 @@ struct EstatisticasSA {
     int movimentosMelhoria;
     int movimentosPiora;
     int reaquecimentos;
+    int migracoesAdotadas;
 
     // Custos
     double custoInicial;
@@ -66,6 +160,10 @@ struct EstatisticasSA {
     double melhorCusto;
     int iteracaoMelhorCusto;
 
+    // Parada
+    long long iteracoesExecutadas;
+    CriterioParada criterioParada;
+
     // Histórico
     std::vector<double> historicoCusto;
     std::vector<double> historicoTemperatura;
@@ -74,11 +172,22 @@ struct EstatisticasSA {
     // Tempo
     double tempoExecucao; // em segundos
 
+    // Por ilha (vazio fora do modelo de ilhas)
+    std::vector<EstatisticasIlha> ilhas;
+
+    // Por tipo de movimento (índice = TipoMovimento)
+    std::array<EstatisticasMovimento, NUM_TIPOS_MOVIMENTO> porMovimento;
+    // Probabilidade atual de cada tipo na seleção adaptativa
+    std::array<double, NUM_TIPOS_MOVIMENTO> pesosMovimento;
+
     EstatisticasSA()
         : movimentosAceitos(0), movimentosRejeitados(0),
           movimentosMelhoria(0), movimentosPiora(0),
-          reaquecimentos(0), custoInicial(0), custoFinal(0),
-          melhorCusto(0), iteracaoMelhorCusto(0), tempoExecucao(0) {}
+          reaquecimentos(0), migracoesAdotadas(0), custoInicial(0), custoFinal(0),
+          melhorCusto(0), iteracaoMelhorCusto(0), iteracoesExecutadas(0),
+          criterioParada(CriterioParada::ITERACOES), tempoExecucao(0) {
+        pesosMovimento.fill(1.0 / NUM_TIPOS_MOVIMENTO);
+    }
 
     double getTaxaAceitacao() const {
         int total = movimentosAceitos + movimentosRejeitados;
@@ -91,35 +200,24 @@ struct EstatisticasSA {
     }
 };
 
-// Tipos de movimentos possíveis
-enum class TipoMovimento {
-    TROCAR_HORARIO,      // Troca horário mantendo dia
-    TROCAR_DIA,          // Troca dia mantendo horário
-    TROCAR_SLOT,         // Troca dia e horário
-    TROCAR_AULAS,        // Troca duas aulas de lugar
-    MOVER_BLOCO,         // Move bloco de aulas consecutivas
-    OTIMIZAR_PROFESSOR,  // Otimiza horário de um professor
-    OTIMIZAR_TURMA       // Otimiza horário de uma turma
+// Tabela da telemetria por tipo de movimento no console
+void mostrarTelemetriaMovimentos(const EstatisticasSA& estatisticas);
+
+// Mudança de slot de uma aula (posição na solução)
+struct AlteracaoSlot {
+    int aula;
+    Slot anterior;
+    Slot novo;
 };
 
-// Movimento realizado (para lista tabu)
+// Movimento: sorteado em selecionarMovimento, completado por gerarVizinho
+// e usado na verificação de viabilidade e na memória tabu
 struct Movimento {
     TipoMovimento tipo;
-    std::vector<int> parametros; // IDs envolvidos
-    size_t hash;
+    std::vector<int> parametros; // Índices envolvidos (aulas, turma/disciplina, professor)
+    std::vector<AlteracaoSlot> alteracoes; // Registro aplicado sobre a solução atual
 
     Movimento(TipoMovimento t) : tipo(t) {}
-
-    void calcularHash() {
-        hash = std::hash<int>()(static_cast<int>(tipo));
-        for (int p : parametros) {
-            hash ^= std::hash<int>()(p) << 1;
-        }
-    }
-
-    bool operator==(const Movimento& outro) const {
-        return hash == outro.hash;
-    }
 };
 
 class SimulatedAnnealing {
@@ -136,13 +234,32 @@ public:
         ConfiguracaoSA config = ConfiguracaoSA()
     );
 
+    // Construtor a partir de uma instância já compilada (compartilhável)
+    SimulatedAnnealing(
+        std::vector<Aula> solucaoInicial,
+        std::shared_ptr<const InstanciaCompilada> instancia,
+        ConfiguracaoSA config = ConfiguracaoSA()
+    );
+
     // Métodos principais
     void executar();
     void executarComCallback(std::function<void(int, double, double)> callback);
     void pararExecucao() { executando = false; }
 
+    // Execução como réplica de temperatura fixa (TemperaturaParalela)
+    void executarPassos(int numPassos);
+    void refinarMelhorSolucao();
+    void setTemperatura(double temperatura) { temperaturaAtual = temperatura; }
+    double getTemperatura() const { return temperaturaAtual; }
+    double getCustoAtual() const { return estatisticas.custoFinal; }
+    void setAleatorio(const Aleatorio& fluxo) { gen = fluxo; }
+
+    // Migração entre execuções (ModeloIlhas)
+    const std::vector<AulaCompacta>& getMelhorSolucaoCompacta() const { return melhorSolucao; }
+    bool adotarSolucao(const std::vector<AulaCompacta>& solucao);
+
     // Acesso aos resultados
-    std::vector<Aula> getSolucaoFinal() const { return melhorSolucao; }
+    std::vector<Aula> getSolucaoFinal() const;
     double getCustoFinal() const { return melhorCusto; }
     EstatisticasSA getEstatisticas() const { return estatisticas; }
 
@@ -160,15 +277,43 @@ public:
     }
 
 private:
+    // Micro-benchmarks dos métodos internos (Benchmark.cpp)
+    friend class AcessoBenchmark;
+
     // Dados do problema
-    std::vector<Aula> solucaoAtual;
-    std::vector<Aula> melhorSolucao;
-    std::vector<Professor> professores;
-    std::vector<Disciplina> disciplinas;
-    std::vector<Turma> turmas;
-    std::vector<Sala> salas;
-    std::set<std::tuple<int, int, int>> disponibilidadeProfessores;
-    std::map<int, int> turmaSalaMap;
+    std::vector<AulaCompacta> solucaoAtual;
+    std::vector<AulaCompacta> melhorSolucao;
+    std::shared_ptr<const InstanciaCompilada> instancia;
+    // Aulas recebidas, usadas apenas para devolver a solução final com os
+    // IDs e metadados originais. Os movimentos só alteram slots: a posição i
+    // de qualquer solução manipulada pelo SA é sempre a mesma aula.
+    std::vector<Aula> aulasOriginais;
+    // Posições das aulas de cada turma / professor / sala exclusiva
+    // (fixas durante a execução)
+    std::vector<std::vector<int>> aulasPorTurma;
+    std::vector<std::vector<int>> aulasPorProfessor;
+    std::vector<std::vector<int>> aulasPorSala;
+    // Aulas de cada grupo (turma, disciplina); os grupos da turma t são
+    // [primeiroGrupoTurma[t], primeiroGrupoTurma[t + 1])
+    std::vector<std::vector<int>> aulasPorGrupo;
+    std::vector<int> primeiroGrupoTurma;
+    std::vector<int> grupoDaAula;
+    // Índice denso (0..numRepresentantes-1) da classe de aulas idênticas
+    // (mesmo grupo, professor e sala) de cada aula. Aulas idênticas são
+    // intercambiáveis: o hash e a memória tabu usam o representante, e trocas
+    // entre elas não são geradas
+    std::vector<int> representanteAula;
+    int numRepresentantes;
+    // Blocos geminados: pares de aulas idênticas de disciplina geminada em
+    // slots seguidos do mesmo dia na solução inicial. Os movimentos mantêm
+    // cada par junto; só moverGeminada os muda de lugar
+    std::vector<std::array<int, 2>> paresGeminados;
+    std::vector<std::vector<int>> paresGeminadosPorTurma;
+    std::vector<int> parceiroGeminada; // Outra aula do bloco, -1 se avulsa
+    std::vector<int> aulasAvulsas;
+    // Tipos na seleção, em ordem: OTIMIZAR_TURMA nunca entra, MOVER_GEMINADA
+    // só com blocos, e sai o tipo sem nenhuma proposta viável no aquecimento
+    std::vector<int> tiposAtivos;
     std::function<void(int, int, double)> progressCallback;
 
     // Configuração e estado
@@ -177,56 +322,163 @@ private:
     double temperaturaAtual;
     double melhorCusto;
     bool executando;
-
-    // Lista tabu
-    std::deque<Movimento> listaTabu;
+    int iteracoesExecutadas; // Contador de executarPassos
+
+    // Memória tabu por atributo: a chave representante * 30 + slot marca um
+    // slot que a aula (ou uma idêntica) deixou recentemente. O anel guarda as
+    // últimas tamanhoListaTabu chaves e contagemTabu (indexado pela própria
+    // chave, numRepresentantes * 30 posições) responde em O(1)
+    std::vector<int> anelTabu;
+    std::vector<int> contagemTabu;
+    size_t posicaoAnelTabu;
+    size_t ocupacaoAnelTabu;
+
+    // Seleção adaptativa: recompensa média de cada tipo de movimento
+    // (melhoria por aula tocada, suavizada exponencialmente); as
+    // probabilidades ficam em estatisticas.pesosMovimento
+    std::array<double, NUM_TIPOS_MOVIMENTO> recompensaMovimento;
 
     // Gerador de números aleatórios
-    std::mt19937 gen;
-    std::uniform_real_distribution<> dis;
-    std::uniform_int_distribution<> disMovimento;
+    Aleatorio gen;
 
     // Cache para otimização
-    mutable std::map<size_t, double> cacheCusto;
+    CacheCusto cacheCusto;
     mutable std::map<std::pair<int, int>, std::vector<int>> cacheHorariosProfessor;
 
+    // Contribuições de cada turma/dia/professor para o custo da solução atual.
+    // As somas são guardadas sem peso para continuarem válidas se os pesos mudarem.
+    struct ContribuicoesCusto {
+        std::vector<double> distribuicaoTurma;    // Penalidade 1 por turma
+        std::vector<double> consecutivasTurmaDia; // Penalidade 2 por turma * 5 + dia
+        std::vector<double> janelasProfessor;     // Penalidade 3 por professor
+        double somaDistribuicao = 0.0;
+        double somaConsecutivas = 0.0;
+        double somaJanelas = 0.0;
+        double somaExtremos = 0.0;                // Penalidade 4 (soma por aula)
+        double somaPreferencias = 0.0;            // Penalidade 5 (soma por aula)
+    };
+
+    // Contribuições recalculadas para o vizinho avaliado por último,
+    // aplicadas ao cache apenas se o movimento for aceito
+    struct AlteracaoContribuicoes {
+        std::vector<std::pair<int, double>> turmas;
+        std::vector<std::pair<int, double>> turmaDias;
+        std::vector<std::pair<int, double>> professores;
+        double deltaDistribuicao = 0.0;
+        double deltaConsecutivas = 0.0;
+        double deltaJanelas = 0.0;
+        double deltaExtremos = 0.0;
+        double deltaPreferencias = 0.0;
+        bool divergente = false;
+    };
+
+    ContribuicoesCusto contribuicoes;
+    AlteracaoContribuicoes alteracaoPendente;
+
+    // Ocupação da solução atual (índice denso -> máscara de slots), mantida
+    // a cada movimento aplicado ou desfeito
+    std::vector<MascaraSlots> ocupacaoProfessor;
+    std::vector<MascaraSlots> ocupacaoTurma;
+    std::vector<MascaraSlots> ocupacaoSala;
+
+    // Slots anteriores das aulas alteradas pelo movimento em avaliação
+    std::vector<std::pair<int, Slot>> registroDesfazer;
+
+    // Hash Zobrist: um valor aleatório de 64 bits por (representante, slot);
+    // o hash de uma solução é o XOR dos valores de cada aula no seu slot, e
+    // um movimento o atualiza trocando apenas os termos das aulas alteradas.
+    // Soluções que só permutam aulas idênticas têm o mesmo hash. A tabela é
+    // compartilhada entre as instâncias do processo
+    std::shared_ptr<const std::vector<uint64_t>> tabelaZobrist;
+    uint64_t hashAtual;
+
     // Métodos de custo
-    double calcularCusto(const std::vector<Aula>& solucao);
-    double calcularCustoIncremental(const std::vector<Aula>& solucao,
-                                   const Movimento& movimento);
+    double calcularCusto(const std::vector<AulaCompacta>& solucao);
+    double calcularCusto(const std::vector<AulaCompacta>& solucao, uint64_t hashSolucao);
+    uint64_t calcularHash(const std::vector<AulaCompacta>& solucao) const;
+    uint64_t valorZobrist(int aula, const Slot& slot) const {
+        return (*tabelaZobrist)[representanteAula[aula] * NUM_SLOTS + slot.getId()];
+    }
+    bool aulasIdenticas(int a, int b) const { return representanteAula[a] == representanteAula[b]; }
+    double calcularCustoIncremental(const Movimento& movimento);
+    void confirmarCustoIncremental();
+    void inicializarContribuicoes(const std::vector<AulaCompacta>& solucao);
+    double combinarPenalidades(double distribuicao, double consecutivas, double janelas,
+                               double extremos, double preferencias) const;
+
+    // Contribuições individuais (mesmas regras das penalidades completas)
+    double contribuicaoDistribuicao(const std::vector<AulaCompacta>& solucao, int turma) const;
+    double contribuicaoConsecutivas(const std::vector<AulaCompacta>& solucao, int turma, int dia) const;
+    double contribuicaoJanelas(const std::vector<AulaCompacta>& solucao, int professor) const;
+    double penalidadeExtremosAula(int aula, const Slot& slot) const;
+    double penalidadePreferenciasAula(int aula, const Slot& slot) const;
 
     // Componentes do custo
-    double calcularPenalidade1(const std::vector<Aula>& solucao) const; // Distribuição
-    double calcularPenalidade2(const std::vector<Aula>& solucao) const; // Consecutivas
-    double calcularPenalidade3(const std::vector<Aula>& solucao) const; // Janelas
-    double calcularPenalidade4(const std::vector<Aula>& solucao) const; // Extremos
-    double calcularPenalidade5(const std::vector<Aula>& solucao) const; // Preferências
+    double calcularPenalidade1(const std::vector<AulaCompacta>& solucao) const; // Distribuição
+    double calcularPenalidade2(const std::vector<AulaCompacta>& solucao) const; // Consecutivas
+    double calcularPenalidade3(const std::vector<AulaCompacta>& solucao) const; // Janelas
+    double calcularPenalidade4(const std::vector<AulaCompacta>& solucao) const; // Extremos
+    double calcularPenalidade5(const std::vector<AulaCompacta>& solucao) const; // Preferências
+    MatrizDias contarAulasPorTurmaDia(const std::vector<AulaCompacta>& solucao) const;
 
     // Análise detalhada
-    std::map<int, std::vector<int>> obterJanelasPorProfessor(const std::vector<Aula>& solucao) const;
-    std::map<int, double> obterDistribuicaoPorTurma(const std::vector<Aula>& solucao) const;
-    int contarAulasConsecutivasTotal(const std::vector<Aula>& solucao) const;
+    std::vector<MascaraSlots> ocupacaoPorProfessor(const std::vector<AulaCompacta>& solucao) const;
+    std::map<int, double> obterDistribuicaoPorTurma(const std::vector<AulaCompacta>& solucao) const;
+    int contarAulasConsecutivasTotal(const std::vector<AulaCompacta>& solucao) const;
 
     // Geração de vizinhos
-    std::vector<Aula> gerarVizinho(const std::vector<Aula>& solucao);
+    void gerarVizinho(Movimento& movimento);
     Movimento selecionarMovimento();
+    void atualizarSelecaoAdaptativa(TipoMovimento tipo, double recompensa);
+    void desativarTipoMovimento(TipoMovimento tipo);
+    void sortearParametros(Movimento& movimento);
     bool movimentoTabu(const Movimento& mov) const;
     void adicionarTabu(const Movimento& mov);
-
-    // Tipos de movimento específicos
-    std::vector<Aula> trocarHorario(const std::vector<Aula>& solucao);
-    std::vector<Aula> trocarDia(const std::vector<Aula>& solucao);
-    std::vector<Aula> trocarSlot(const std::vector<Aula>& solucao);
-    std::vector<Aula> trocarAulas(const std::vector<Aula>& solucao);
-    std::vector<Aula> moverBloco(const std::vector<Aula>& solucao);
-    std::vector<Aula> otimizarProfessor(const std::vector<Aula>& solucao);
-    std::vector<Aula> otimizarTurma(const std::vector<Aula>& solucao);
+    void limparTabu();
+
+    // Tipos de movimento específicos (preenchem movimento.alteracoes a partir
+    // da solução atual, sem aplicá-las). As realocações de uma aula sorteiam
+    // o destino entre os slots livres (slotsLivres)
+    MascaraSlots slotsLivres(int aula) const;
+    bool trocaViavel(int a, int b) const;
+    int sortearAulaAvulsa();
+    std::array<int, 2> aulasDoBloco(int par) const; // Ordenadas por slot
+    void realocarOuTrocar(Movimento& movimento, MascaraSlots destinos);
+    void trocarNaTurma(Movimento& movimento, MascaraSlots destinos);
+    void trocarHorario(Movimento& movimento);
+    void trocarDia(Movimento& movimento);
+    void trocarSlot(Movimento& movimento);
+    void trocarAulas(Movimento& movimento);
+    void cadeiaKempe(Movimento& movimento);
+    void moverBloco(Movimento& movimento);
+    void otimizarProfessor(Movimento& movimento);
+    void otimizarTurma(Movimento& movimento);
+    void moverGeminada(Movimento& movimento);
+
+    // Aplicação em lugar sobre a solução atual
+    void aplicarMovimento(const Movimento& movimento);
+    void desfazerMovimento();
+    void ocuparSlot(int aula, const Slot& slot);
+    void liberarSlot(int aula, const Slot& slot);
+    void reconstruirOcupacao();
 
     // Validação
-    bool verificarViabilidade(const std::vector<Aula>& solucao);
-    bool verificarViabilidadeRapida(const std::vector<Aula>& solucao,
-                                   const Movimento& movimento);
-    ResultadoValidacao validarSolucaoCompleta(const std::vector<Aula>& solucao);
+    bool verificarViabilidade(const std::vector<AulaCompacta>& solucao);
+    bool verificarViabilidadeRapida(const Movimento& movimento);
+    bool preservaGeminadas(const Movimento& movimento) const;
+    bool geminadasIntactas(const std::vector<AulaCompacta>& solucao) const;
+    ResultadoValidacao validarSolucaoCompleta(const std::vector<AulaCompacta>& solucao);
+
+    // Resultado de uma iteração de Metropolis
+    enum class ResultadoIteracao {
+        INVIAVEL,    // Movimento gerou conflito
+        TABU,        // Rejeitado pela memória tabu
+        REJEITADO,   // Rejeitado pelo critério de Metropolis
+        ACEITO,
+        NOVO_MELHOR  // Aceito e melhor custo encontrado até agora
+    };
+    ResultadoIteracao executarIteracao(int iter);
+    ResultadoIteracao avaliarMovimento(const Movimento& movimento, int iter, double& deltaCusto);
 
     // Controle de temperatura
     bool aceitarMovimento(double deltaCusto);
@@ -242,6 +494,20 @@ private:
     std::string formatarTempo(double segundos) const;
 
     // Busca local (melhoria adicional)
-    std::vector<Aula> buscaLocal2opt(const std::vector<Aula>& solucao);
-    std::vector<Aula> buscaLocalJanelas(const std::vector<Aula>& solucao);
+    std::vector<AulaCompacta> buscaLocalJanelas(const std::vector<AulaCompacta>& solucao);
+
+    // Polimento final sobre a solução atual: trocas entre aulas do mesmo
+    // professor ou turma e realocações para slots livres, avaliadas em
+    // paralelo a partir da ocupação e das contribuições, sem copiar a solução
+    struct CandidatoPolimento {
+        double delta = 0.0;
+        int aula = -1;   // Aula movida
+        int outra = -1;  // Aula que vai para o slot de `aula` (-1 = realocação)
+        int slot = -1;   // Slot de destino de `aula`
+    };
+    int polirSolucaoAtual();
+    CandidatoPolimento varrerPolimento(int origem, int inicio, int fim, bool primeiraMelhoria) const;
+    bool avaliarCandidatoPolimento(int aula, int outra, int slot, double& delta) const;
+    int getNumThreadsPolimento() const;
+    void definirSolucaoAtual(const std::vector<AulaCompacta>& solucao, uint64_t hashSolucao);
 };
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "TemperaturaParalela.h"
+#include "Barreira.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+int threadsDisponiveis() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return 1; // WebAssembly sem suporte a threads
+#else
+    return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+#endif
+}
+
+} // namespace
+
+TemperaturaParalela::TemperaturaParalela(
+    std::vector<Aula> solucaoInicial,
+    std::shared_ptr<const InstanciaCompilada> instancia,
+    ConfiguracaoTemperaturaParalela config)
+    : config(config), melhorReplica(0), custoInicial(0.0), tempoExecucao(0.0),
+      rodadasExecutadas(0), criterioParada(CriterioParada::ITERACOES)
+{
+    int numReplicas = config.numReplicas > 0 ? config.numReplicas
+                                              : std::max(threadsDisponiveis(), MIN_REPLICAS_PADRAO);
+    numReplicas = std::max(numReplicas, 2);
+
+    numThreads = config.numThreads > 0 ? config.numThreads : threadsDisponiveis();
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    numThreads = 1;
+#endif
+    numThreads = std::min(numThreads, numReplicas);
+
+    semente = config.configSA.semente != 0 ? config.configSA.semente : sementeNaoDeterministica();
+
+    ConfiguracaoSA configReplica = config.configSA;
+    configReplica.verboso = false;
+
+    // Escada geométrica entre as temperaturas mínima e máxima
+    double tMin = std::max(config.temperaturaMinima, 1e-6);
+    double tMax = std::max(config.temperaturaMaxima, tMin);
+    double razao = std::pow(tMax / tMin, 1.0 / (numReplicas - 1));
+
+    degraus.resize(numReplicas);
+    for (int k = 0; k < numReplicas; k++) {
+        auto replica = std::make_unique<SimulatedAnnealing>(solucaoInicial, instancia, configReplica);
+
+        replica->setAleatorio(Aleatorio::fluxo(semente, k));
+
+        degraus[k].temperatura = tMin * std::pow(razao, k);
+        replica->setTemperatura(degraus[k].temperatura);
+
+        replicas.push_back(std::move(replica));
+        replicaNoDegrau.push_back(k);
+    }
+
+    aceitosAnteriores.assign(numReplicas, 0);
+    rejeitadosAnteriores.assign(numReplicas, 0);
+    custoInicial = replicas.front()->getCustoAtual();
+}
+
+void TemperaturaParalela::executar() {
+    auto inicio = std::chrono::high_resolution_clock::now();
+
+    if (config.verboso) {
+        std::cout << "\n=== INICIANDO TEMPERATURA PARALELA ===" << std::endl;
+        std::cout << "Réplicas: " << replicas.size() << " em " << numThreads << " thread(s)" << std::endl;
+        std::cout << "Escada: " << std::fixed << std::setprecision(2)
+                  << degraus.front().temperatura << " a " << degraus.back().temperatura << std::endl;
+        std::cout << "Rodadas: " << config.numRodadas << " x " << config.passosPorRodada
+                  << " passos por réplica" << std::endl;
+    }
+
+    const int numReplicas = static_cast<int>(replicas.size());
+    Aleatorio genTrocas = Aleatorio::fluxo(semente, numReplicas);
+
+    // Parada antecipada, decidida só no fechamento das rodadas: prazo
+    // esgotado ou janelaConvergencia passos por réplica sem novo melhor custo
+    const Prazo& prazo = config.configSA.prazo;
+    const long long janela = config.configSA.janelaConvergencia;
+    double melhorCustoJanela = getCustoFinal();
+    int rodadaMelhoria = 0;
+    rodadasExecutadas = 0;
+    criterioParada = prazo.esgotado() ? CriterioParada::PRAZO : CriterioParada::ITERACOES;
+    bool parar = criterioParada != CriterioParada::ITERACOES;
+
+    // Fase sequencial entre rodadas: contadores, trocas, parada e progresso
+    auto fecharRodada = [&](int rodada) {
+        registrarRodada();
+        fazerTrocas(rodada, genTrocas);
+        atualizarMelhorReplica();
+        rodadasExecutadas = rodada + 1;
+
+        if (getCustoFinal() < melhorCustoJanela) {
+            melhorCustoJanela = getCustoFinal();
+            rodadaMelhoria = rodada + 1;
+        }
+        if (prazo.esgotado()) {
+            criterioParada = CriterioParada::PRAZO;
+            parar = true;
+        } else if (janela > 0 && static_cast<long long>(rodada + 1 - rodadaMelhoria) * config.passosPorRodada >= janela) {
+            criterioParada = CriterioParada::CONVERGENCIA;
+            parar = true;
+        }
+
+        if (callbackProgresso) {
+            callbackProgresso(rodada + 1, config.numRodadas, replicas[melhorReplica]->getCustoFinal());
+        }
+        if (config.verboso && (rodada + 1) % std::max(config.numRodadas / 10, 1) == 0) {
+            std::cout << "Rodada " << std::setw(5) << (rodada + 1) << "/" << config.numRodadas
+                      << " | Melhor=" << std::fixed << std::setprecision(2) << std::setw(10)
+                      << replicas[melhorReplica]->getCustoFinal() << std::endl;
+        }
+    };
+
+    if (numThreads == 1) {
+        for (int rodada = 0; rodada < config.numRodadas && !parar; rodada++) {
+            for (auto& replica : replicas) {
+                replica->executarPassos(config.passosPorRodada);
+            }
+            fecharRodada(rodada);
+        }
+    } else {
+        // Cada thread avança um subconjunto fixo de réplicas; a thread 0
+        // fecha a rodada enquanto as demais aguardam na segunda barreira
+        // (depois dela, todas leem o mesmo `parar`)
+        Barreira barreira(numThreads);
+        auto worker = [&](int indice) {
+            for (int rodada = 0; rodada < config.numRodadas && !parar; rodada++) {
+                for (int r = indice; r < numReplicas; r += numThreads) {
+                    replicas[r]->executarPassos(config.passosPorRodada);
+                }
+                barreira.aguardar();
+                if (indice == 0) {
+                    fecharRodada(rodada);
+                }
+                barreira.aguardar();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads - 1);
+        for (int t = 1; t < numThreads; t++) {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    // Busca local final sobre a melhor réplica
+    atualizarMelhorReplica();
+    replicas[melhorReplica]->refinarMelhorSolucao();
+    atualizarMelhorReplica();
+
+    auto fim = std::chrono::high_resolution_clock::now();
+    tempoExecucao = std::chrono::duration<double>(fim - inicio).count();
+
+    if (config.verboso) {
+        std::cout << "\n=== TEMPERATURA PARALELA CONCLUÍDA ===" << std::endl;
+        std::cout << "Parada: " << nomeCriterioParada(criterioParada) << " após "
+                  << rodadasExecutadas << "/" << config.numRodadas << " rodadas" << std::endl;
+        std::cout << "Tempo de execução: " << std::fixed << std::setprecision(2)
+                  << tempoExecucao << "s" << std::endl;
+        std::cout << "Custo inicial: " << custoInicial << std::endl;
+        std::cout << "Custo final: " << getCustoFinal() << std::endl;
+    }
+}
+
+// Atribui os movimentos da rodada ao degrau em que cada réplica estava
+void TemperaturaParalela::registrarRodada() {
+    for (size_t k = 0; k < degraus.size(); k++) {
+        int r = replicaNoDegrau[k];
+        EstatisticasSA estatisticasReplica = replicas[r]->getEstatisticas();
+
+        degraus[k].movimentosAceitos += estatisticasReplica.movimentosAceitos - aceitosAnteriores[r];
+        degraus[k].movimentosRejeitados += estatisticasReplica.movimentosRejeitados - rejeitadosAnteriores[r];
+        aceitosAnteriores[r] = estatisticasReplica.movimentosAceitos;
+        rejeitadosAnteriores[r] = estatisticasReplica.movimentosRejeitados;
+    }
+}
+
+// Trocas entre degraus vizinhos: pares (0,1), (2,3)... nas rodadas pares
+// e (1,2), (3,4)... nas ímpares
+void TemperaturaParalela::fazerTrocas(int rodada, Aleatorio& gen) {
+    for (size_t k = rodada % 2; k + 1 < degraus.size(); k += 2) {
+        SimulatedAnnealing& fria = *replicas[replicaNoDegrau[k]];
+        SimulatedAnnealing& quente = *replicas[replicaNoDegrau[k + 1]];
+
+        double expoente = (1.0 / degraus[k].temperatura - 1.0 / degraus[k + 1].temperatura) *
+                          (fria.getCustoAtual() - quente.getCustoAtual());
+
+        degraus[k].trocasPropostas++;
+        if (expoente >= 0 || gen.real() < std::exp(expoente)) {
+            degraus[k].trocasAceitas++;
+            std::swap(replicaNoDegrau[k], replicaNoDegrau[k + 1]);
+            replicas[replicaNoDegrau[k]]->setTemperatura(degraus[k].temperatura);
+            replicas[replicaNoDegrau[k + 1]]->setTemperatura(degraus[k + 1].temperatura);
+        }
+    }
+}
+
+void TemperaturaParalela::atualizarMelhorReplica() {
+    for (size_t r = 0; r < replicas.size(); r++) {
+        if (replicas[r]->getCustoFinal() < replicas[melhorReplica]->getCustoFinal()) {
+            melhorReplica = static_cast<int>(r);
+        }
+    }
+}
+
+std::vector<Aula> TemperaturaParalela::getSolucaoFinal() const {
+    return replicas[melhorReplica]->getSolucaoFinal();
+}
+
+double TemperaturaParalela::getCustoFinal() const {
+    return replicas[melhorReplica]->getCustoFinal();
+}
+
+EstatisticasSA TemperaturaParalela::getEstatisticas() const {
+    EstatisticasSA total;
+    total.pesosMovimento.fill(0.0);
+    for (const auto& replica : replicas) {
+        EstatisticasSA e = replica->getEstatisticas();
+        total.movimentosAceitos += e.movimentosAceitos;
+        total.movimentosRejeitados += e.movimentosRejeitados;
+        total.movimentosMelhoria += e.movimentosMelhoria;
+        total.movimentosPiora += e.movimentosPiora;
+        total.iteracoesExecutadas += e.iteracoesExecutadas;
+        for (int t = 0; t < NUM_TIPOS_MOVIMENTO; t++) {
+            total.porMovimento[t].acumular(e.porMovimento[t]);
+            total.pesosMovimento[t] += e.pesosMovimento[t] / replicas.size(); // Média das réplicas
+        }
+    }
+
+    total.custoInicial = custoInicial;
+    total.custoFinal = getCustoFinal();
+    total.melhorCusto = getCustoFinal();
+    total.iteracaoMelhorCusto = replicas[melhorReplica]->getEstatisticas().iteracaoMelhorCusto;
+    total.criterioParada = criterioParada;
+    total.tempoExecucao = tempoExecucao;
+    return total;
+}
+
+void TemperaturaParalela::mostrarEstatisticas() const {
+    EstatisticasSA total = getEstatisticas();
+
+    std::cout << "\n=== ESTATÍSTICAS DA TEMPERATURA PARALELA ===" << std::endl;
+    std::cout << "Tempo de execução: " << std::fixed << std::setprecision(2)
+              << total.tempoExecucao << "s" << std::endl;
+    std::cout << "Réplicas: " << replicas.size() << " | Threads: " << numThreads << std::endl;
+    std::cout << "Movimentos aceitos: " << total.movimentosAceitos << std::endl;
+    std::cout << "Movimentos rejeitados: " << total.movimentosRejeitados << std::endl;
+    std::cout << "Rodadas: " << rodadasExecutadas << "/" << config.numRodadas
+              << " (parada: " << nomeCriterioParada(criterioParada) << ")" << std::endl;
+    std::cout << "Custo inicial: " << total.custoInicial << std::endl;
+    std::cout << "Custo final: " << total.custoFinal << std::endl;
+
+    mostrarTelemetriaMovimentos(total);
+
+    std::cout << "\nDegrau | Temperatura | Aceitação | Troca com o seguinte" << std::endl;
+    for (size_t k = 0; k < degraus.size(); k++) {
+        std::cout << std::setw(6) << k << " | "
+                  << std::setw(11) << degraus[k].temperatura << " | "
+                  << std::setw(8) << degraus[k].getTaxaAceitacao() << "% | ";
+        if (k + 1 < degraus.size()) {
+            std::cout << std::setw(6) << degraus[k].getTaxaTroca() << "% ("
+                      << degraus[k].trocasAceitas << "/" << degraus[k].trocasPropostas << ")";
+        } else {
+            std::cout << "-";
+        }
+        std::cout << std::endl;
+    }
+}
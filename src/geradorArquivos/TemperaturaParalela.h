@@ -0,0 +1,107 @@
+#pragma once
+#include "Estruturas.h"
+#include "InstanciaCompilada.h"
+#include "SimulatedAnnealing.h"
+#include <vector>
+#include <memory>
+#include <functional>
+
+// ==============================================================================
+// TEMPERATURA PARALELA (TROCA DE RÉPLICAS)
+// ==============================================================================
+
+// Escadas com poucos degraus quase não trocam estados: o padrão usa pelo
+// menos este número de réplicas, mesmo com menos núcleos
+constexpr int MIN_REPLICAS_PADRAO = 8;
+
+// Configurações da troca de réplicas
+struct ConfiguracaoTemperaturaParalela {
+    int numReplicas = 0;             // 0 = um por núcleo, no mínimo MIN_REPLICAS_PADRAO
+    int numThreads = 0;              // 0 = uma por núcleo (nunca mais que as réplicas)
+    double temperaturaMinima = 0.5;  // Degrau mais frio da escada
+    double temperaturaMaxima = 100.0; // Degrau mais quente da escada
+    int numRodadas = 200;            // Rodadas de passos seguidas de uma fase de trocas
+    int passosPorRodada = 250;       // Iterações de cada réplica por rodada
+    bool verboso = false;
+    ConfiguracaoSA configSA;         // Pesos, memória tabu, cache, semente mestre e parada
+                                     // (prazo; janelaConvergencia em passos por réplica)
+};
+
+// Estatísticas de um degrau da escada
+struct EstatisticasDegrau {
+    double temperatura = 0.0;
+    int movimentosAceitos = 0;
+    int movimentosRejeitados = 0;
+    int trocasPropostas = 0;         // Trocas com o degrau seguinte (mais quente)
+    int trocasAceitas = 0;
+
+    double getTaxaAceitacao() const {
+        int total = movimentosAceitos + movimentosRejeitados;
+        return total > 0 ? (double)movimentosAceitos / total * 100 : 0;
+    }
+
+    double getTaxaTroca() const {
+        return trocasPropostas > 0 ? (double)trocasAceitas / trocasPropostas * 100 : 0;
+    }
+};
+
+// Várias cadeias do SA, cada uma numa temperatura fixa de uma escada
+// geométrica, executadas em threads separadas. Ao fim de cada rodada, pares
+// de degraus vizinhos (alternando pares pares e ímpares) trocam de estado
+// pelo critério de Metropolis:
+//   P = min(1, exp((1/T_i - 1/T_j) * (E_i - E_j)))
+// A troca é feita permutando as temperaturas entre as réplicas, o que
+// equivale a trocar os estados sem copiá-los. Substitui o resfriamento
+// geométrico e o reaquecimento do SA de cadeia única. A réplica k usa o
+// fluxo k da semente de configSA e as trocas usam o fluxo numReplicas, então
+// o resultado não depende do número de threads. O prazo e a janela de
+// convergência de configSA são verificados no fechamento de cada rodada.
+class TemperaturaParalela {
+public:
+    TemperaturaParalela(
+        std::vector<Aula> solucaoInicial,
+        std::shared_ptr<const InstanciaCompilada> instancia,
+        ConfiguracaoTemperaturaParalela config = ConfiguracaoTemperaturaParalela()
+    );
+
+    void executar();
+
+    // Chamado ao fim de cada rodada com (rodada, total de rodadas, melhor custo)
+    void setCallbackProgresso(std::function<void(int, int, double)> callback) {
+        callbackProgresso = callback;
+    }
+
+    // Acesso aos resultados
+    std::vector<Aula> getSolucaoFinal() const;
+    double getCustoFinal() const;
+    EstatisticasSA getEstatisticas() const; // Contadores somados de todas as réplicas
+    const std::vector<EstatisticasDegrau>& getEstatisticasDegraus() const { return degraus; }
+    int getNumReplicas() const { return static_cast<int>(replicas.size()); }
+    int getNumThreads() const { return numThreads; }
+
+    void mostrarEstatisticas() const;
+
+private:
+    ConfiguracaoTemperaturaParalela config;
+    std::vector<std::unique_ptr<SimulatedAnnealing>> replicas;
+    std::vector<int> replicaNoDegrau;   // Degrau -> réplica que está nele
+    std::vector<EstatisticasDegrau> degraus;
+    int numThreads;
+    uint64_t semente; // Semente mestre dos fluxos das réplicas e das trocas
+    int melhorReplica;
+    double custoInicial;
+    double tempoExecucao;
+    int rodadasExecutadas;
+    CriterioParada criterioParada;
+
+    // Contadores de cada réplica no fim da rodada anterior, para atribuir
+    // os movimentos da rodada ao degrau em que a réplica estava
+    std::vector<int> aceitosAnteriores;
+    std::vector<int> rejeitadosAnteriores;
+
+    std::function<void(int, int, double)> callbackProgresso;
+
+    void registrarRodada();
+    void fazerTrocas(int rodada, Aleatorio& gen);
+    void atualizarMelhorReplica();
+};